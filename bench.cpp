@@ -0,0 +1,1411 @@
+/**
+ * @file bench.cpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A benchmark file for the bigint class
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "bigint.hpp"
+#include "bigint_accumulator.hpp"
+#include "bigint_arena.hpp"
+#include "bigint_expr.hpp"
+#include "bigint_file.hpp"
+#include "bigint_matrix.hpp"
+#include "bigint_memo.hpp"
+#include "bigint_parser.hpp"
+#include "bigint_pool.hpp"
+#include "bigint_scan.hpp"
+#include "bigint_sort.hpp"
+#include "disk_bigint.hpp"
+#include "hashed_bigint.hpp"
+#include "modint.hpp"
+#include "shared_bigint.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/**
+ * @brief Bytes currently held by live heap allocations, as seen by the allocator.
+ *
+ * With glibc this is the usable size of each block plus one size word of chunk
+ * header, i.e. what the allocator really sets aside. Elsewhere each block starts
+ * with a header recording its requested size, and the value is the sum of the
+ * requested sizes, a lower bound. Atomic because the matrix benchmarks allocate
+ * from worker threads.
+ *
+ */
+static std::atomic<size_t> live_heap_bytes{0};
+
+#ifndef __GLIBC__
+/**
+ * @brief The bytes in front of each block that record its requested size.
+ *
+ * A whole alignment unit, so the address handed out keeps malloc's alignment.
+ *
+ */
+static constexpr size_t size_header = alignof(std::max_align_t);
+#endif
+
+/**
+ * @brief Takes a block from the C heap and counts it as live.
+ *
+ * @param size The size requested by operator new
+ * @return void* The block to hand out, or nullptr if the heap is exhausted
+ */
+static void *acquire_block(size_t size)
+{
+#ifdef __GLIBC__
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr)
+        live_heap_bytes.fetch_add(malloc_usable_size(ptr) + sizeof(size_t), std::memory_order_relaxed);
+    return ptr;
+#else
+    if (size > SIZE_MAX - size_header)
+        return nullptr;
+    char *base = static_cast<char *>(std::malloc(size_header + size));
+    if (!base)
+        return nullptr;
+    std::memcpy(base, &size, sizeof(size));
+    live_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    return base + size_header;
+#endif
+}
+
+/**
+ * @brief Gives a block back to the C heap and stops counting it.
+ *
+ * Both forms of operator delete go through here, so every block is uncounted
+ * by the same amount it was counted with. Kept out of line so the compiler
+ * doesn't pair the replaced operator delete with the standard operator new
+ * when it inlines through the allocators.
+ *
+ * @param ptr The block returned by acquire_block
+ */
+__attribute__((noinline)) static void release_block(void *ptr)
+{
+#ifdef __GLIBC__
+    live_heap_bytes.fetch_sub(malloc_usable_size(ptr) + sizeof(size_t), std::memory_order_relaxed);
+    std::free(ptr);
+#else
+    char *base = static_cast<char *>(ptr) - size_header;
+    size_t size;
+    std::memcpy(&size, base, sizeof(size));
+    live_heap_bytes.fetch_sub(size, std::memory_order_relaxed);
+    std::free(base);
+#endif
+}
+
+void *operator new(size_t size)
+{
+    void *ptr = acquire_block(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (ptr)
+        release_block(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    if (ptr)
+        release_block(ptr);
+}
+
+/**
+ * @brief A set of hardware performance counters read around a measured region.
+ *
+ * On Linux the counters are opened with `perf_event_open` for the calling thread
+ * (user space only). Counters the kernel or the CPU doesn't support are simply
+ * left closed, so the harness still runs inside containers and virtual machines
+ * where `perf` is unavailable; `available()` tells whether anything was opened.
+ *
+ */
+class perf_counters
+{
+public:
+    /**
+     * @brief Indices of the counters kept by the set.
+     *
+     */
+    enum counter
+    {
+        cycles,
+        instructions,
+        l1d_misses,
+        llc_misses,
+        branch_misses,
+        count
+    };
+
+    /**
+     * @brief Open every counter that the running system supports.
+     *
+     */
+    perf_counters()
+    {
+#ifdef __linux__
+        fds[cycles] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds[instructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[l1d_misses] = open_counter(PERF_TYPE_HW_CACHE,
+                                       PERF_COUNT_HW_CACHE_L1D |
+                                           (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        fds[llc_misses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds[branch_misses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    perf_counters(const perf_counters &) = delete;
+    perf_counters &operator=(const perf_counters &) = delete;
+
+    /**
+     * @brief Close the counters that were opened.
+     *
+     */
+    ~perf_counters()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+#endif
+    }
+
+    /**
+     * @brief Checks whether at least one counter could be opened.
+     *
+     * @return true if some counter is available
+     * @return false otherwise
+     */
+    bool available() const
+    {
+        for (int fd : fds)
+            if (fd >= 0)
+                return true;
+        return false;
+    }
+
+    /**
+     * @brief Checks whether a specific counter could be opened.
+     *
+     * @param c The counter to check
+     * @return true if the counter is available
+     * @return false otherwise
+     */
+    bool has(counter c) const
+    {
+        return fds[c] >= 0;
+    }
+
+    /**
+     * @brief Reset and enable all open counters.
+     *
+     */
+    void start()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+        {
+            if (fd < 0)
+                continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Disable all open counters and read their values.
+     *
+     * Counters that are closed (or fail to read) report 0.
+     *
+     */
+    void stop()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0)
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = 0;
+            if (fds[i] >= 0 && read(fds[i], &values[i], sizeof(values[i])) != sizeof(values[i]))
+                values[i] = 0;
+        }
+#endif
+    }
+
+    /**
+     * @brief Returns the value of a counter from the last start()/stop() pair.
+     *
+     * @param c The counter to read
+     * @return uint64_t The number of events counted
+     */
+    uint64_t value(counter c) const
+    {
+        return values[c];
+    }
+
+private:
+    /**
+     * @brief File descriptors of the counters, -1 for unavailable ones.
+     *
+     */
+    int fds[count] = {-1, -1, -1, -1, -1};
+
+    /**
+     * @brief Counter values from the last measured region.
+     *
+     */
+    uint64_t values[count] = {0, 0, 0, 0, 0};
+
+#ifdef __linux__
+    /**
+     * @brief Open a single disabled user-space counter for the calling thread.
+     *
+     * @param type The perf event type
+     * @param config The perf event configuration
+     * @return int The file descriptor, or -1 if the event can't be opened
+     */
+    static int open_counter(uint32_t type, uint64_t config)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+};
+
+/**
+ * @brief Options shared by all benchmarks.
+ *
+ */
+struct bench_options
+{
+    /**
+     * @brief Read the hardware counters around each measured operation.
+     *
+     */
+    bool perf = false;
+
+    /**
+     * @brief Only run benchmarks whose name contains one of these strings.
+     *
+     */
+    std::vector<std::string> filters;
+
+    /**
+     * @brief Checks whether a benchmark was selected on the command line.
+     *
+     * @param name The benchmark name
+     * @return true if there are no filters or the name contains one of them
+     * @return false otherwise
+     */
+    bool selected(const std::string &name) const
+    {
+        if (filters.empty())
+            return true;
+        for (const std::string &filter : filters)
+            if (name.find(filter) != std::string::npos)
+                return true;
+        return false;
+    }
+};
+
+/**
+ * @brief Generates a random decimal string with exactly the given number of digits.
+ *
+ * @param digits The number of digits (at least 1)
+ * @param rng The random engine to draw digits from
+ * @return std::string The generated digit string, without leading zeros
+ */
+std::string random_digits(size_t digits, std::mt19937_64 &rng)
+{
+    std::uniform_int_distribution<int> first(1, 9);
+    std::uniform_int_distribution<int> rest(0, 9);
+
+    std::string str(1, static_cast<char>('0' + first(rng)));
+    for (size_t i = 1; i < digits; ++i)
+        str.push_back(static_cast<char>('0' + rest(rng)));
+    return str;
+}
+
+/**
+ * @brief Prints the measurements of one benchmark, without the line break.
+ *
+ * @param counters The counter set holding the values of the measured region
+ * @param name The benchmark name
+ * @param limbs The number of limbs (digits) processed by one operation
+ * @param reps The number of operations in the measured region
+ * @param ns The average wall time per operation in nanoseconds
+ * @param measure Whether the counters were read around the region
+ */
+void print_result(const perf_counters &counters, const std::string &name, size_t limbs, size_t reps, double ns, bool measure)
+{
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(10) << limbs
+              << std::setw(16) << std::fixed << std::setprecision(1) << ns;
+
+    if (measure)
+    {
+        double per_op = static_cast<double>(reps);
+        double per_limb = per_op * static_cast<double>(limbs);
+        uint64_t cycles = counters.value(perf_counters::cycles);
+        uint64_t instructions = counters.value(perf_counters::instructions);
+
+        std::cout << std::setw(14) << std::setprecision(0) << static_cast<double>(cycles) / per_op;
+        if (counters.has(perf_counters::cycles) && counters.has(perf_counters::instructions) && cycles > 0)
+            std::cout << std::setw(8) << std::setprecision(2) << static_cast<double>(instructions) / static_cast<double>(cycles);
+        else
+            std::cout << std::setw(8) << "-";
+        std::cout << std::setw(12) << std::setprecision(3) << static_cast<double>(counters.value(perf_counters::l1d_misses)) / per_limb
+                  << std::setw(12) << static_cast<double>(counters.value(perf_counters::llc_misses)) / per_limb
+                  << std::setw(12) << static_cast<double>(counters.value(perf_counters::branch_misses)) / per_limb;
+    }
+}
+
+/**
+ * @brief Runs one benchmark and prints a line of results.
+ *
+ * The operation is repeated until at least `min_time` has elapsed (and at least
+ * once), and the averages per operation are reported. When counters are enabled
+ * and available, IPC and misses per limb are derived from the same region;
+ * `limbs` is the number of digits the operation works on and is used to
+ * normalize the miss counts.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set, used only if `opts.perf` is set
+ * @param name The benchmark name
+ * @param limbs The number of limbs (digits) processed by one operation
+ * @param op The operation to measure
+ */
+template <typename Op>
+void run_benchmark(const bench_options &opts, perf_counters &counters, const std::string &name, size_t limbs, Op op)
+{
+    if (!opts.selected(name))
+        return;
+
+    using clock = std::chrono::steady_clock;
+    const auto min_time = std::chrono::milliseconds(200);
+
+    // Warm up caches and the allocator once outside of the measured region
+    op();
+
+    size_t reps = 0;
+    bool measure = opts.perf && counters.available();
+    if (measure)
+        counters.start();
+    auto begin = clock::now();
+    auto end = begin;
+    do
+    {
+        op();
+        ++reps;
+        end = clock::now();
+    } while (end - begin < min_time);
+    if (measure)
+        counters.stop();
+
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(reps);
+    print_result(counters, name, limbs, reps, ns, measure);
+    std::cout << '\n';
+}
+
+/**
+ * @brief Runs one end-to-end workload once and prints a line of results.
+ *
+ * Workloads take long enough that a single run is representative. The workload
+ * returns whether its result matched the known answer, so the line doubles as
+ * a regression anchor; a mismatch is flagged at the end of the line.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set, used only if `opts.perf` is set
+ * @param name The benchmark name
+ * @param limbs The number of limbs (digits) of the result
+ * @param op The workload to measure, returning true if its result is correct
+ */
+template <typename Op>
+void run_macro(const bench_options &opts, perf_counters &counters, const std::string &name, size_t limbs, Op op)
+{
+    if (!opts.selected(name))
+        return;
+
+    using clock = std::chrono::steady_clock;
+
+    bool measure = opts.perf && counters.available();
+    if (measure)
+        counters.start();
+    auto begin = clock::now();
+    bool correct = op();
+    auto end = clock::now();
+    if (measure)
+        counters.stop();
+
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    print_result(counters, name, limbs, 1, ns, measure);
+    std::cout << (correct ? "" : "  MISMATCH") << '\n';
+}
+
+/**
+ * @brief Prints the header of the result table.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void print_header(const bench_options &opts, const perf_counters &counters)
+{
+    std::cout << std::left << std::setw(24) << "benchmark" << std::right
+              << std::setw(10) << "limbs"
+              << std::setw(16) << "ns/op";
+    if (opts.perf && counters.available())
+        std::cout << std::setw(14) << "cycles/op"
+                  << std::setw(8) << "IPC"
+                  << std::setw(12) << "L1D/limb"
+                  << std::setw(12) << "LLC/limb"
+                  << std::setw(12) << "br-mis/limb";
+    std::cout << '\n';
+}
+
+/**
+ * @brief Benchmarks the arithmetic operators over a range of operand sizes.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_arithmetic(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(12345);
+
+    for (size_t digits : {100, 1000, 10000})
+    {
+        bigint a(random_digits(digits, rng));
+        bigint b(random_digits(digits, rng));
+        bigint neg_b = -b;
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "add" + suffix, digits, [&]
+                      { bigint r = a + b; });
+        run_benchmark(opts, counters, "sub" + suffix, digits, [&]
+                      { bigint r = a - b; });
+        run_benchmark(opts, counters, "add_mixed_sign" + suffix, digits, [&]
+                      { bigint r = a + neg_b; });
+        run_benchmark(opts, counters, "mul" + suffix, 2 * digits, [&]
+                      { bigint r = a * b; });
+    }
+
+    // Division by repeated subtraction is quadratic with a large constant,
+    // keep the sizes small enough for a quick run
+    for (size_t digits : {100, 1000})
+    {
+        bigint a(random_digits(2 * digits, rng));
+        bigint b(random_digits(digits, rng));
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "div" + suffix, 2 * digits, [&]
+                      { bigint r = a / b; });
+        run_benchmark(opts, counters, "mod" + suffix, 2 * digits, [&]
+                      { bigint r = a % b; });
+    }
+
+    // Modular multiplication with a reduction by % against Montgomery form
+    for (size_t digits : {100, 1000})
+    {
+        bigint n(random_digits(digits - 1, rng) + "7");
+        bigint a = bigint(random_digits(digits, rng)) % n;
+        bigint b = bigint(random_digits(digits, rng)) % n;
+        auto context = std::make_shared<const montgomery_context>(n);
+        dyn_modint x(a, context), y(b, context);
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "mulmod_operator" + suffix, digits, [&]
+                      { bigint r = (a * b) % n; });
+        run_benchmark(opts, counters, "mulmod_montgomery" + suffix, digits, [&]
+                      { dyn_modint r = x * y; });
+    }
+}
+
+/**
+ * @brief Benchmarks the matrix products, each method on the same operands.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_matrix(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(24680);
+
+    for (auto [n, digits] : {std::make_pair<size_t, size_t>(16, 20), std::make_pair<size_t, size_t>(16, 200), std::make_pair<size_t, size_t>(8, 1000)})
+    {
+        std::vector<bigint> a_entries, b_entries;
+        for (size_t i = 0; i < n * n; ++i)
+        {
+            a_entries.push_back(bigint(random_digits(digits, rng)));
+            b_entries.push_back(-bigint(random_digits(digits, rng)));
+        }
+        bigint_matrix a(n, n, a_entries), b(n, n, b_entries);
+        std::string suffix = "/" + std::to_string(n) + "x" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "matrix_blocked" + suffix, n * n * digits, [&]
+                      { bigint_matrix r = bigint_matrix::multiply_blocked(a, b); });
+        run_benchmark(opts, counters, "matrix_strassen" + suffix, n * n * digits, [&]
+                      { bigint_matrix r = bigint_matrix::multiply_strassen(a, b); });
+        run_benchmark(opts, counters, "matrix_multimodular" + suffix, n * n * digits, [&]
+                      { bigint_matrix r = bigint_matrix::multiply_multimodular(a, b); });
+    }
+}
+
+/**
+ * @brief Benchmarks the conversions between bigint and strings.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_conversion(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(67890);
+
+    for (size_t digits : {100, 1000, 10000})
+    {
+        std::string str = random_digits(digits, rng);
+        bigint a(str);
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "from_string" + suffix, digits, [&]
+                      { bigint r(str); });
+        run_benchmark(opts, counters, "to_string_10" + suffix, digits, [&]
+                      { std::string r = a.to_string(10); });
+        run_benchmark(opts, counters, "to_string_16" + suffix, digits, [&]
+                      { std::string r = a.to_string(16); });
+
+        // Streaming into a sink that only counts, as a file or socket writer would see it
+        volatile size_t written = 0;
+        run_benchmark(opts, counters, "write_digits_10" + suffix, digits, [&]
+                      { a.write_digits([&](const char *, size_t size)
+                                       { written = written + size; }); });
+        run_benchmark(opts, counters, "write_digits_7" + suffix, digits, [&]
+                      { a.write_digits([&](const char *, size_t size)
+                                       { written = written + size; },
+                                       7); });
+    }
+}
+
+/**
+ * @brief Benchmarks the generation of random values, from strings and directly.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_random(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(97531);
+    bigint::counter_engine engine(97531);
+
+    for (size_t digits : {100, 1000})
+    {
+        std::string suffix = "/" + std::to_string(digits);
+        std::vector<bigint> values(100);
+
+        run_benchmark(opts, counters, "random_from_string" + suffix, digits, [&]
+                      { bigint r(random_digits(digits, rng)); });
+        run_benchmark(opts, counters, "random_digits" + suffix, digits, [&]
+                      { bigint r = bigint::random_digits(digits, rng); });
+        run_benchmark(opts, counters, "random_counter" + suffix, digits, [&]
+                      { bigint r = bigint::random_digits(digits, engine); });
+        run_benchmark(opts, counters, "random_fill" + suffix, digits * values.size(), [&]
+                      { bigint::fill_random(values.begin(), values.end(), digits, engine); });
+        bigint bound = bigint(random_digits(digits, rng));
+        run_benchmark(opts, counters, "random_below" + suffix, digits, [&]
+                      { bigint r = bigint::random_below(bound, engine); });
+        run_benchmark(opts, counters, "random_bits" + suffix, digits, [&]
+                      { bigint r = bigint::random_bits(digits * 10 / 3, engine); });
+    }
+}
+
+/**
+ * @brief Benchmarks hashing bigint keys, through strings and directly.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_hash(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(11235);
+    // The hashes are stored so that they aren't optimized away
+    volatile size_t sink = 0;
+
+    for (size_t digits : {20, 100, 1000})
+    {
+        bigint a(random_digits(digits, rng));
+        hashed_bigint cached(a);
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "hash_string" + suffix, digits, [&]
+                      { sink = std::hash<std::string>()(a.to_string(10)); });
+        run_benchmark(opts, counters, "hash" + suffix, digits, [&]
+                      { sink = std::hash<bigint>()(a); });
+        run_benchmark(opts, counters, "hash_cached" + suffix, digits, [&]
+                      { sink = std::hash<hashed_bigint>()(cached); });
+    }
+}
+
+/**
+ * @brief Benchmarks interning values that are already in a pool.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_pool(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(81321);
+    bigint_pool pool;
+
+    for (size_t digits : {20, 1000})
+    {
+        std::string str = random_digits(digits, rng);
+        bigint a(str);
+        bigint_pool::handle kept = pool.intern(a);
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "intern" + suffix, digits, [&]
+                      { bigint_pool::handle h = pool.intern(a); });
+        run_benchmark(opts, counters, "intern_string" + suffix, digits, [&]
+                      { bigint_pool::handle h = pool.intern(str); });
+    }
+    bigint_pool::handle kept = pool.intern(int64_t(1234567890123));
+    run_benchmark(opts, counters, "intern_int64", 13, [&]
+                  { bigint_pool::handle h = pool.intern(int64_t(1234567890123)); });
+}
+
+/**
+ * @brief Benchmarks copying values, with deep and shared storage.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_copy(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(31415);
+
+    for (size_t digits : {20, 1000, 100000})
+    {
+        bigint a(random_digits(digits, rng));
+        shared_bigint shared(a);
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "copy" + suffix, digits, [&]
+                      { bigint r = a; });
+        run_benchmark(opts, counters, "copy_shared" + suffix, digits, [&]
+                      { shared_bigint r = shared; });
+    }
+}
+
+/**
+ * @brief Benchmarks sorting arrays of values with std::sort and bigint_sort.
+ *
+ * Each run sorts a fresh copy of the same array, so both include the copy.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_sort(const bench_options &opts, perf_counters &counters)
+{
+    bigint::counter_engine gen(27182);
+
+    for (size_t digits : {20, 200})
+    {
+        std::vector<bigint> values(20000);
+        for (bigint &value : values)
+        {
+            value = bigint::random_digits(digits / 2 + gen() % digits, gen);
+            if (gen() % 2)
+                value = -value;
+        }
+        std::string suffix = "/" + std::to_string(values.size()) + "x" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "sort_std" + suffix, values.size() * digits, [&]
+                      { std::vector<bigint> copy = values; std::sort(copy.begin(), copy.end()); });
+        run_benchmark(opts, counters, "sort_radix" + suffix, values.size() * digits, [&]
+                      { std::vector<bigint> copy = values; bigint_sort::sort(copy.begin(), copy.end()); });
+        run_benchmark(opts, counters, "sort_keys" + suffix, values.size() * digits, [&]
+                      {
+                          std::vector<std::string> keys;
+                          keys.reserve(values.size());
+                          for (const bigint &value : values)
+                              keys.push_back(bigint_sort::key(value));
+                          std::sort(keys.begin(), keys.end()); });
+    }
+}
+
+/**
+ * @brief Benchmarks the block-wise product of disk_bigint against the in-memory product.
+ *
+ * The digit files go to $TMPDIR or /tmp, so the numbers depend on whether
+ * that is a disk or memory.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_disk(const bench_options &opts, perf_counters &counters)
+{
+    bigint::counter_engine gen(16180);
+
+    for (size_t digits : {10000, 100000})
+    {
+        bigint a = bigint::random_digits(digits, gen), b = bigint::random_digits(digits, gen);
+        disk_bigint da(a), db(b);
+        std::string suffix = "/" + std::to_string(digits);
+
+        if (digits <= 10000)
+            run_benchmark(opts, counters, "mul_memory" + suffix, 2 * digits, [&]
+                          { bigint r = a * b; });
+        run_benchmark(opts, counters, "mul_disk" + suffix, 2 * digits, [&]
+                      { disk_bigint r = da * db; });
+        run_benchmark(opts, counters, "mul_disk_blocks" + suffix, 2 * digits, [&]
+                      { disk_bigint r = disk_bigint::multiply(da, db, digits / 8); });
+    }
+}
+
+/**
+ * @brief Benchmarks bigint_parser against the string constructors.
+ *
+ * The parser is fed the text in 4 KB chunks, as read from a file or pipe.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_parser(const bench_options &opts, perf_counters &counters)
+{
+    std::mt19937_64 rng(24680);
+
+    for (size_t digits : {1000, 10000, 100000})
+    {
+        std::string decimal = random_digits(digits, rng), hex;
+        for (size_t i = 0; i < digits; ++i)
+            hex.push_back("0123456789ABCDEF"[rng() % 16]);
+        std::string suffix = "/" + std::to_string(digits);
+        auto parse = [](const std::string &text, int base)
+        {
+            bigint_parser parser(base);
+            for (size_t i = 0; i < text.size(); i += 4096)
+                parser.feed(text.data() + i, std::min<size_t>(4096, text.size() - i));
+            return parser.finish();
+        };
+
+        run_benchmark(opts, counters, "parse_10" + suffix, digits, [&]
+                      { bigint r = parse(decimal, 10); });
+        if (digits <= 10000)
+            run_benchmark(opts, counters, "from_string_16" + suffix, digits, [&]
+                          { bigint r(hex, 16); });
+        run_benchmark(opts, counters, "parse_16" + suffix, digits, [&]
+                      { bigint r = parse(hex, 16); });
+    }
+}
+
+/**
+ * @brief Benchmarks values shared through a bigint_arena against private copies.
+ *
+ * get_compare looks a value up and compares it without copying its digits;
+ * the products show the cost of materializing a view as an operand.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_arena(const bench_options &opts, perf_counters &counters)
+{
+    bigint::counter_engine gen(31415);
+    bigint_arena arena(size_t(1) << 16);
+
+    for (size_t digits : {100, 10000})
+    {
+        bigint a = bigint::random_digits(digits, gen), b = bigint::random_digits(digits, gen);
+        bigint_arena::offset at = arena.store(a);
+        std::string suffix = "/" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "arena_get_compare" + suffix, digits, [&]
+                      { volatile bool equal = arena.get(at) == a; (void)equal; });
+        run_benchmark(opts, counters, "arena_copy" + suffix, digits, [&]
+                      { bigint r = arena.get(at).to_bigint(); });
+        if (digits <= 1000)
+        {
+            run_benchmark(opts, counters, "mul_private" + suffix, 2 * digits, [&]
+                          { bigint r = a * b; });
+            run_benchmark(opts, counters, "mul_view" + suffix, 2 * digits, [&]
+                          { bigint r = arena.get(at) * b; });
+        }
+    }
+}
+
+/**
+ * @brief Benchmarks bigint_file against reading one value per call.
+ *
+ * The file stays in the page cache, so this measures the calls and copies
+ * rather than the disk.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_file(const bench_options &opts, perf_counters &counters)
+{
+    bigint::counter_engine gen(27183);
+    const char *tmpdir = std::getenv("TMPDIR");
+    std::string path = std::string(tmpdir && *tmpdir ? tmpdir : "/tmp") + "/bigint_bench_" + std::to_string(getpid());
+
+    for (size_t digits : {40, 4000})
+    {
+        std::vector<bigint> values(4000000 / digits);
+        bigint::fill_random(values.begin(), values.end(), digits, gen);
+        bigint_file::save(path, values.begin(), values.end());
+        std::string suffix = "/" + std::to_string(values.size()) + "x" + std::to_string(digits);
+
+        // Every value has the same length, so its digits are at a known offset
+        size_t start = (32 + 8 * values.size() + 4095) / 4096 * 4096;
+        run_benchmark(opts, counters, "load_per_value" + suffix, values.size() * digits, [&]
+                      {
+                          int fd = open(path.c_str(), O_RDONLY);
+                          std::vector<bigint> loaded(values.size());
+                          std::string digits_read(digits, '0'), text(digits, '0');
+                          for (size_t i = 0; i < loaded.size(); ++i)
+                          {
+                              if (pread(fd, &digits_read[0], digits, static_cast<off_t>(start + i * digits)) != static_cast<ssize_t>(digits))
+                                  break;
+                              for (size_t k = 0; k < digits; ++k)
+                                  text[digits - 1 - k] = static_cast<char>('0' + digits_read[k]);
+                              loaded[i] = bigint(text);
+                          }
+                          close(fd); });
+        run_benchmark(opts, counters, "load_batched" + suffix, values.size() * digits, [&]
+                      { std::vector<bigint> loaded = bigint_file::load(path); });
+        std::vector<bigint> reused(values.size());
+        run_benchmark(opts, counters, "load_reused" + suffix, values.size() * digits, [&]
+                      { bigint_file::load(path, reused.begin(), reused.end()); });
+    }
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Benchmarks summing a sequence with bigint_accumulator against operator+=.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_accumulate(const bench_options &opts, perf_counters &counters)
+{
+    bigint::counter_engine gen(16803);
+
+    for (size_t digits : {30, 1000})
+    {
+        std::vector<bigint> values(2000000 / digits);
+        bigint::fill_random(values.begin(), values.end(), digits, gen);
+        std::string suffix = "/" + std::to_string(values.size()) + "x" + std::to_string(digits);
+
+        run_benchmark(opts, counters, "sum_operator" + suffix, values.size() * digits, [&]
+                      {
+                          bigint total(0);
+                          for (const bigint &value : values)
+                              total += value;
+                      });
+        run_benchmark(opts, counters, "sum_accumulator" + suffix, values.size() * digits, [&]
+                      {
+                          bigint_accumulator total;
+                          for (const bigint &value : values)
+                              total += value;
+                          bigint r = total.value();
+                      });
+    }
+}
+
+/**
+ * @brief Benchmarks prefix sums with operator+ against bigint_scan.
+ *
+ * scan_operator builds every prefix sum as a new bigint, scan_inclusive reuses
+ * the output of the previous run, and scan_parallel uses the two-pass scan on
+ * bigint_scan's thread count.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_scan(const bench_options &opts, perf_counters &counters)
+{
+    bigint::counter_engine gen(5150);
+    std::vector<bigint> values(20000);
+    bigint::fill_random(values.begin(), values.end(), 100, gen);
+    std::vector<bigint> out(values.size());
+    std::string suffix = "/" + std::to_string(values.size()) + "x100";
+
+    run_benchmark(opts, counters, "scan_operator" + suffix, values.size() * 100, [&]
+                  {
+                      std::vector<bigint> sums;
+                      sums.reserve(values.size());
+                      bigint running(0);
+                      for (const bigint &value : values)
+                      {
+                          running = running + value;
+                          sums.push_back(running);
+                      }
+                  });
+    run_benchmark(opts, counters, "scan_inclusive" + suffix, values.size() * 100, [&]
+                  { bigint_scan::inclusive_scan(values.begin(), values.end(), out.begin()); });
+    run_benchmark(opts, counters, "scan_parallel" + suffix, values.size() * 100, [&]
+                  { bigint_scan::parallel_inclusive_scan(values.begin(), values.end(), out.begin()); });
+}
+
+/**
+ * @brief Benchmarks bigint_memo against computing every result again.
+ *
+ * Each run asks for the factorials 100!, 200!, ..., 3000! and for 40 binomial
+ * coefficients of 2000: memo_direct with a cache of capacity 0, memo_cold with
+ * an empty cache, so each factorial starts from the previous one, and
+ * memo_warm with a cache that already holds every result.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_memo(const bench_options &opts, perf_counters &counters)
+{
+    auto workload = [](bigint_memo &memo)
+    {
+        size_t digits = 0;
+        for (uint64_t n = 100; n <= 3000; n += 100)
+            digits += memo.factorial(n).digits();
+        for (uint64_t k = 0; k < 2000; k += 50)
+            digits += memo.binomial(2000, k).digits();
+        return digits;
+    };
+
+    bigint_memo warm;
+    size_t digits = workload(warm);
+    run_benchmark(opts, counters, "memo_direct", digits, [&]
+                  {
+                      bigint_memo memo(0);
+                      workload(memo);
+                  });
+    run_benchmark(opts, counters, "memo_cold", digits, [&]
+                  {
+                      bigint_memo memo;
+                      workload(memo);
+                  });
+    run_benchmark(opts, counters, "memo_warm", digits, [&]
+                  { workload(warm); });
+}
+
+/**
+ * @brief Benchmarks a report formula evaluated eagerly against a bigint_expr graph.
+ *
+ * The report has 500 outputs, each the sum of 20 consecutive products of
+ * 200-digit values, so every product appears in 20 outputs, and only every
+ * 50th output is read. expr_eager computes every output with bigint
+ * arithmetic, expr_lazy builds the graph and reads the outputs it needs.
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_expr(const bench_options &opts, perf_counters &counters)
+{
+    bigint::counter_engine gen(31337);
+    std::vector<bigint> values(520);
+    bigint::fill_random(values.begin(), values.end(), 200, gen);
+    const size_t outputs = 500, window = 20;
+
+    run_benchmark(opts, counters, "expr_eager", outputs * window * 200, [&]
+                  {
+                      std::vector<bigint> report;
+                      for (size_t j = 0; j < outputs; ++j)
+                      {
+                          bigint sum(0);
+                          for (size_t i = j; i < j + window; ++i)
+                              sum = sum + values[i] * values[i + 1];
+                          report.push_back(sum);
+                      }
+                  });
+    run_benchmark(opts, counters, "expr_lazy", outputs * window * 200, [&]
+                  {
+                      bigint_expr::graph g;
+                      std::vector<bigint_expr> leaves, report;
+                      for (const bigint &value : values)
+                          leaves.push_back(g.constant(value));
+                      for (size_t j = 0; j < outputs; ++j)
+                      {
+                          bigint_expr sum = g.constant(bigint(0));
+                          for (size_t i = j; i < j + window; ++i)
+                              sum += leaves[i] * leaves[i + 1];
+                          report.push_back(sum);
+                      }
+                      for (size_t j = 0; j < outputs; j += 50)
+                          report[j].value();
+                  });
+}
+
+/**
+ * @brief Computes floor(sqrt(n)) with Newton's iteration.
+ *
+ * @param n The non-negative radicand
+ * @param guess A starting value not below the root
+ * @return bigint The integer square root
+ */
+bigint isqrt(const bigint &n, bigint guess)
+{
+    bigint two(2);
+    while (true)
+    {
+        bigint next = (guess + n / guess) / two;
+        if (next >= guess)
+            return guess;
+        guess = next;
+    }
+}
+
+/**
+ * @brief Returns 10 raised to the given power.
+ *
+ * @param exponent The power of ten
+ * @return bigint The value 10^exponent
+ */
+bigint pow10(size_t exponent)
+{
+    return bigint("1" + std::string(exponent, '0'));
+}
+
+/**
+ * @brief Computes (base ^ exponent) mod modulus by left-to-right binary exponentiation.
+ *
+ * @param base The base, already reduced modulo the modulus
+ * @param exponent The non-negative exponent
+ * @param modulus The positive modulus
+ * @return bigint The modular power
+ */
+bigint powmod(const bigint &base, const bigint &exponent, const bigint &modulus)
+{
+    std::string bits = exponent.to_string(2);
+    bigint result(1);
+    for (char bit : bits)
+    {
+        result = result * result % modulus;
+        if (bit == '1')
+            result = result * base % modulus;
+    }
+    return result;
+}
+
+/**
+ * @brief The terms P, Q and T of a binary splitting range of the Chudnovsky series.
+ *
+ */
+struct chudnovsky_terms
+{
+    bigint p;
+    bigint q;
+    bigint t;
+};
+
+/**
+ * @brief Evaluates the Chudnovsky series terms in [a, b) by binary splitting.
+ *
+ * @param a The first term
+ * @param b One past the last term
+ * @return chudnovsky_terms The combined P, Q and T of the range
+ */
+chudnovsky_terms chudnovsky_split(int64_t a, int64_t b)
+{
+    if (b - a == 1)
+    {
+        chudnovsky_terms leaf;
+        if (a == 0)
+        {
+            leaf.p = 1;
+            leaf.q = 1;
+        }
+        else
+        {
+            leaf.p = bigint(6 * a - 5) * bigint(2 * a - 1) * bigint(6 * a - 1);
+            leaf.q = bigint(a) * bigint(a) * bigint(a) * bigint(10939058860032000);
+        }
+        leaf.t = leaf.p * bigint(13591409 + 545140134 * a);
+        if (a % 2 == 1)
+            leaf.t = -leaf.t;
+        return leaf;
+    }
+
+    int64_t m = (a + b) / 2;
+    chudnovsky_terms left = chudnovsky_split(a, m);
+    chudnovsky_terms right = chudnovsky_split(m, b);
+
+    chudnovsky_terms merged;
+    merged.p = left.p * right.p;
+    merged.q = left.q * right.q;
+    merged.t = left.t * right.q + left.p * right.t;
+    return merged;
+}
+
+/**
+ * @brief Computes floor(pi * 10^digits) with the Chudnovsky series.
+ *
+ * @param digits The number of decimal places
+ * @return bigint The scaled value of pi
+ */
+bigint chudnovsky_pi(size_t digits)
+{
+    // Every term adds a little over 14 correct digits
+    int64_t terms = static_cast<int64_t>(digits / 14 + 2);
+    chudnovsky_terms sum = chudnovsky_split(0, terms);
+
+    // sqrt(10005) * 10^digits, starting Newton from sqrt(10005) ~ 100.025 rounded up
+    bigint scale = pow10(digits);
+    bigint root = isqrt(bigint(10005) * scale * scale, bigint(100025) * scale / bigint(1000) + bigint(1));
+
+    return sum.q * bigint(426880) * root / sum.t;
+}
+
+/**
+ * @brief Runs end-to-end workloads built on the public bigint API.
+ *
+ * - `pi`: Chudnovsky series with binary splitting, checked against known digits
+ * - `factorial`: n! by repeated multiplication, checked by its digit count
+ * - `powmod`: RSA-style public-exponent exponentiation (e = 65537) with 2048-
+ *   and 4096-bit moduli, checked against dyn_modint's Montgomery exponentiation
+ * - `roundtrip`: huge decimal string to bigint and back through the stream operator
+ *
+ * @param opts The benchmark options
+ * @param counters The counter set
+ */
+void bench_macro(const bench_options &opts, perf_counters &counters)
+{
+    const std::string pi_prefix = "31415926535897932384626433832795028841971693993751";
+
+    for (size_t digits : {100, 1000})
+    {
+        run_macro(opts, counters, "pi/" + std::to_string(digits), digits, [&]
+                  {
+                      std::string pi = chudnovsky_pi(digits).to_string(10);
+                      return pi.size() == digits + 1 && pi.compare(0, pi_prefix.size(), pi_prefix) == 0; });
+    }
+
+    // Digit counts of n!, from log10(n!)
+    const std::pair<int64_t, size_t> factorials[] = {{1000, 2568}, {5000, 16326}};
+    for (const auto &factorial : factorials)
+    {
+        run_macro(opts, counters, "factorial/" + std::to_string(factorial.first), factorial.second, [&]
+                  {
+                      bigint result(1);
+                      for (int64_t i = 2; i <= factorial.first; ++i)
+                          result *= bigint(i);
+                      std::ostringstream out;
+                      out << result;
+                      return out.str().size() == factorial.second; });
+    }
+
+    std::mt19937_64 rng(13579);
+    const std::pair<size_t, size_t> moduli[] = {{2048, 617}, {4096, 1234}};
+    for (const auto &modulus_size : moduli)
+    {
+        bigint modulus(random_digits(modulus_size.second, rng));
+        if (modulus % bigint(2) == 0)
+            ++modulus;
+        bigint base = bigint(random_digits(modulus_size.second - 1, rng));
+
+        // Reference from Montgomery exponentiation, which shares no reduction code with powmod
+        auto context = std::make_shared<const montgomery_context>(modulus);
+        bigint expected = dyn_modint(base, context).pow(bigint(65537)).value();
+
+        run_macro(opts, counters, "powmod/" + std::to_string(modulus_size.first), modulus_size.second, [&]
+                  {
+                      bigint result = powmod(base, bigint(65537), modulus);
+                      return result == expected; });
+    }
+
+    for (size_t digits : {10000, 100000})
+    {
+        std::string str = random_digits(digits, rng);
+        run_macro(opts, counters, "roundtrip/" + std::to_string(digits), digits, [&]
+                  {
+                      std::ostringstream out;
+                      out << bigint(str);
+                      return out.str() == str; });
+    }
+}
+
+/**
+ * @brief Measures the memory held by one population of values.
+ *
+ * @param count The number of values in the population
+ * @param digits The number of digits of each value
+ * @param arithmetic Produce the values with `+` instead of parsing them
+ * @param rng The random engine to draw digits from
+ */
+void measure_population(size_t count, size_t digits, bool arithmetic, std::mt19937_64 &rng)
+{
+    std::vector<std::string> strings;
+    strings.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        strings.push_back(random_digits(digits, rng));
+    bigint one(1);
+
+    std::vector<bigint> values;
+    values.reserve(count);
+    size_t before = live_heap_bytes;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (arithmetic)
+            values.push_back(bigint(strings[i]) + one);
+        else
+            values.emplace_back(strings[i]);
+    }
+    size_t heap = live_heap_bytes - before;
+
+    size_t reported = 0;
+    size_t used = 0;
+    for (const bigint &value : values)
+    {
+        reported += value.memory_usage();
+        std::ostringstream out;
+        out << value;
+        used += sizeof(bigint) + out.str().size();
+    }
+
+    // The bytes a packed binary representation of the same magnitude would need
+    double compact = std::ceil(static_cast<double>(digits) * std::log2(10.0) / 8.0);
+    double per_value = static_cast<double>(heap + count * sizeof(bigint)) / static_cast<double>(count);
+
+    std::cout << std::left << std::setw(10) << (arithmetic ? "add" : "parse") << std::right
+              << std::setw(10) << digits
+              << std::setw(14) << std::fixed << std::setprecision(1) << per_value
+              << std::setw(14) << static_cast<double>(reported) / static_cast<double>(count)
+              << std::setw(14) << static_cast<double>(reported - used) / static_cast<double>(count)
+              << std::setw(10) << std::setprecision(2) << per_value / compact << '\n';
+}
+
+/**
+ * @brief Reports the bytes per value for populations of numbers of various sizes.
+ *
+ * For each shrink policy and each size, a population of values is built either by
+ * parsing strings or as the result of an addition, and the table lists:
+ *
+ * - `bytes/value`: object size plus everything the heap allocator set aside
+ * - `usage/value`: what `bigint::memory_usage()` reports
+ * - `slack/value`: unused vector capacity
+ * - `vs packed`: bytes/value relative to a packed binary magnitude
+ *
+ * @param opts The benchmark options
+ */
+void bench_memory(const bench_options &opts)
+{
+    if (!opts.selected("memory"))
+        return;
+
+    const std::pair<bigint::shrink_policy, const char *> policies[] = {
+        {bigint::shrink_policy::never, "never"},
+        {bigint::shrink_policy::slack, "slack"},
+        {bigint::shrink_policy::always, "always"}};
+
+    bigint::shrink_policy saved = bigint::get_shrink_policy();
+    std::mt19937_64 rng(24680);
+
+    for (const auto &policy : policies)
+    {
+        bigint::set_shrink_policy(policy.first);
+        std::cout << "\nmemory, shrink policy " << policy.second << ":\n"
+                  << std::left << std::setw(10) << "source" << std::right
+                  << std::setw(10) << "digits"
+                  << std::setw(14) << "bytes/value"
+                  << std::setw(14) << "usage/value"
+                  << std::setw(14) << "slack/value"
+                  << std::setw(10) << "vs packed" << '\n';
+
+        for (size_t digits : {1, 10, 100, 1000, 10000})
+        {
+            size_t count = digits >= 1000 ? 1000 : 10000;
+            measure_population(count, digits, false, rng);
+            measure_population(count, digits, true, rng);
+        }
+    }
+
+    bigint::set_shrink_policy(saved);
+}
+
+/**
+ * @brief Main function to execute all benchmarks.
+ *
+ * Usage: `bench [--perf] [filter...]`
+ *
+ * - `--perf` reads hardware performance counters around each benchmark.
+ * - `filter` runs only the benchmarks whose name contains one of the filters.
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return int Exit status.
+ */
+int main(int argc, char **argv)
+{
+    bench_options opts;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--perf")
+            opts.perf = true;
+        else
+            opts.filters.push_back(arg);
+    }
+
+    perf_counters counters;
+    if (opts.perf && !counters.available())
+        std::cout << "Hardware performance counters are unavailable, reporting wall time only.\n";
+
+    print_header(opts, counters);
+    bench_arithmetic(opts, counters);
+    bench_conversion(opts, counters);
+    bench_random(opts, counters);
+    bench_hash(opts, counters);
+    bench_pool(opts, counters);
+    bench_copy(opts, counters);
+    bench_sort(opts, counters);
+    bench_disk(opts, counters);
+    bench_parser(opts, counters);
+    bench_arena(opts, counters);
+    bench_file(opts, counters);
+    bench_accumulate(opts, counters);
+    bench_scan(opts, counters);
+    bench_memo(opts, counters);
+    bench_expr(opts, counters);
+    bench_matrix(opts, counters);
+    bench_macro(opts, counters);
+    bench_memory(opts);
+}
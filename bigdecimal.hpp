@@ -0,0 +1,478 @@
+/**
+ * @file bigdecimal.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigdecimal
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGDECIMAL_HPP
+#define BIGDECIMAL_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief A class for arbitrary-precision decimal fixed-point numbers
+ *
+ * The value is `coefficient * 10^-scale`, e.g. 123.4500 has the coefficient
+ * 1234500 and the scale 4. Since bigint stores decimal digits, changing the scale
+ * only inserts or drops digits of the coefficient.
+ *
+ */
+class bigdecimal
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * @param out an instance of std::ostream
+     * @param num the bigdecimal object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const bigdecimal &num)
+    {
+        return out << num.to_string();
+    }
+
+public:
+    /**
+     * @brief Rounding modes used when digits are dropped.
+     *
+     * - `half_even`: round to nearest, ties to an even last digit (banker's rounding)
+     * - `half_up`: round to nearest, ties away from zero
+     * - `toward_zero`: truncate
+     *
+     */
+    enum class rounding_mode
+    {
+        half_even,
+        half_up,
+        toward_zero
+    };
+
+    /**
+     * @brief Checks if two bigdecimal numbers are equal
+     *
+     * Numbers with different scales are equal if their values are, e.g. 1.5 == 1.50.
+     *
+     * @param rhs The bigdecimal to compare with
+     * @return true if both bigdecimal numbers are equal
+     * @return false otherwise
+     */
+    bool operator==(const bigdecimal &rhs) const
+    {
+        if (sc == rhs.sc)
+            return coeff == rhs.coeff;
+        size_t scale = std::max(sc, rhs.sc);
+        return aligned(scale) == rhs.aligned(scale);
+    }
+
+    /**
+     * @brief Check if two bigdecimal numbers are not equal
+     *
+     * @param rhs The bigdecimal to compare with
+     * @return true if the bigdecimal numbers are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const bigdecimal &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Compares if the current bigdecimal is less than the given bigdecimal
+     *
+     * @param rhs The bigdecimal to compare with
+     * @return true if the current bigdecimal is less than the given bigdecimal
+     * @return false otherwise
+     */
+    bool operator<(const bigdecimal &rhs) const
+    {
+        if (sc == rhs.sc)
+            return coeff < rhs.coeff;
+        size_t scale = std::max(sc, rhs.sc);
+        return aligned(scale) < rhs.aligned(scale);
+    }
+
+    /**
+     * @brief Compares if the current bigdecimal is less than or equal to the given bigdecimal
+     *
+     * @param rhs The bigdecimal to compare with
+     * @return true if the current bigdecimal is less than or equal to the given bigdecimal
+     * @return false otherwise
+     */
+    bool operator<=(const bigdecimal &rhs) const
+    {
+        return !(rhs < *this);
+    }
+
+    /**
+     * @brief Compares if the current bigdecimal is greater than the given bigdecimal
+     *
+     * @param rhs The bigdecimal to compare with
+     * @return true if the current bigdecimal is greater than the given bigdecimal
+     * @return false otherwise
+     */
+    bool operator>(const bigdecimal &rhs) const
+    {
+        return rhs < *this;
+    }
+
+    /**
+     * @brief Compares if the current bigdecimal is greater than or equal to the given bigdecimal
+     *
+     * @param rhs The bigdecimal to compare with
+     * @return true if the current bigdecimal is greater than or equal to the given bigdecimal
+     * @return false otherwise
+     */
+    bool operator>=(const bigdecimal &rhs) const
+    {
+        return !(*this < rhs);
+    }
+
+    /**
+     * @brief Adds two bigdecimal numbers
+     *
+     * The sum has the larger scale of both operands and is exact.
+     *
+     * @param rhs The bigdecimal to add to the current bigdecimal
+     * @return bigdecimal A new one representing the sum
+     */
+    bigdecimal operator+(const bigdecimal &rhs) const
+    {
+        if (sc == rhs.sc)
+            return bigdecimal(coeff + rhs.coeff, sc);
+        size_t scale = std::max(sc, rhs.sc);
+        return bigdecimal(aligned(scale) + rhs.aligned(scale), scale);
+    }
+
+    /**
+     * @brief Subtracts the given bigdecimal from the current bigdecimal
+     *
+     * The difference has the larger scale of both operands and is exact.
+     *
+     * @param rhs The bigdecimal to subtract
+     * @return bigdecimal A new one representing the difference
+     */
+    bigdecimal operator-(const bigdecimal &rhs) const
+    {
+        if (sc == rhs.sc)
+            return bigdecimal(coeff - rhs.coeff, sc);
+        size_t scale = std::max(sc, rhs.sc);
+        return bigdecimal(aligned(scale) - rhs.aligned(scale), scale);
+    }
+
+    /**
+     * @brief Multiplies two bigdecimal numbers
+     *
+     * The product has the sum of both scales and is exact.
+     *
+     * @param rhs The bigdecimal to multiply with the current bigdecimal
+     * @return bigdecimal A new one representing the product
+     */
+    bigdecimal operator*(const bigdecimal &rhs) const
+    {
+        return bigdecimal(coeff * rhs.coeff, sc + rhs.sc);
+    }
+
+    /**
+     * @brief Divides the current bigdecimal by the given bigdecimal
+     *
+     * The quotient has the larger scale of both operands and uses banker's rounding;
+     * use divide() to choose the scale and the rounding mode.
+     *
+     * @param rhs The bigdecimal divisor
+     * @return bigdecimal A new one representing the quotient
+     */
+    bigdecimal operator/(const bigdecimal &rhs) const
+    {
+        return divide(rhs, std::max(sc, rhs.sc), rounding_mode::half_even);
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return bigdecimal& A reference to the current object after the operation
+     */
+    bigdecimal &operator+=(const bigdecimal &rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return bigdecimal& A reference to the current object after the operation
+     */
+    bigdecimal &operator-=(const bigdecimal &rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return bigdecimal& A reference to the current object after the operation
+     */
+    bigdecimal &operator*=(const bigdecimal &rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment /= overloading
+     *
+     * @param rhs right hand side
+     * @return bigdecimal& A reference to the current object after the operation
+     */
+    bigdecimal &operator/=(const bigdecimal &rhs)
+    {
+        *this = *this / rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return bigdecimal A negated bigdecimal value
+     */
+    bigdecimal operator-() const
+    {
+        return bigdecimal(-coeff, sc);
+    }
+
+    /**
+     * @brief Divides by the given bigdecimal with a chosen scale and rounding mode.
+     *
+     * @param rhs The bigdecimal divisor
+     * @param scale The scale of the quotient
+     * @param mode The rounding mode for the dropped digits
+     * @return bigdecimal The rounded quotient
+     */
+    bigdecimal divide(const bigdecimal &rhs, size_t scale, rounding_mode mode) const
+    {
+        if (rhs.coeff == 0)
+            throw std::invalid_argument("Division by zero");
+
+        // One extra digit plus a sticky digit are enough to round the quotient
+        int64_t shift = static_cast<int64_t>(scale + 1 + rhs.sc) - static_cast<int64_t>(sc);
+        bigint dividend = coeff.shift10(std::max<int64_t>(shift, 0));
+        bigint divisor = rhs.coeff.shift10(std::max<int64_t>(-shift, 0));
+        bigint quotient = dividend / divisor;
+
+        quotient = quotient.shift10(1);
+        if (quotient * divisor != dividend.shift10(1))
+            quotient += (coeff < 0) != (rhs.coeff < 0) ? bigint(-1) : bigint(1);
+        return bigdecimal(round_digits(quotient, 2, mode), scale);
+    }
+
+    /**
+     * @brief Returns the value with another scale.
+     *
+     * A larger scale appends zeros and is exact; a smaller scale drops digits and
+     * rounds them in the given mode.
+     *
+     * @param scale The new scale
+     * @param mode The rounding mode for the dropped digits
+     * @return bigdecimal The rescaled value
+     */
+    bigdecimal rescale(size_t scale, rounding_mode mode = rounding_mode::half_even) const
+    {
+        if (scale >= sc)
+            return bigdecimal(aligned(scale), scale);
+        return bigdecimal(round_digits(coeff, sc - scale, mode), scale);
+    }
+
+    /**
+     * @brief Adds up a range of bigdecimal numbers exactly.
+     *
+     * Values with the same scale are added as plain coefficients, and every group
+     * total is aligned to the largest scale once at the end, instead of aligning
+     * the running total at every addition.
+     *
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @return bigdecimal The sum, with the largest scale of the range
+     */
+    template <typename InputIt>
+    static bigdecimal sum(InputIt first, InputIt last)
+    {
+        std::map<size_t, bigint> totals;
+        for (; first != last; ++first)
+        {
+            const bigdecimal &value = *first;
+            totals[value.sc] += value.coeff;
+        }
+        if (totals.empty())
+            return bigdecimal();
+
+        size_t scale = totals.rbegin()->first;
+        bigint total(0);
+        for (const auto &group : totals)
+            total += group.second.shift10(static_cast<int64_t>(scale - group.first));
+        return bigdecimal(total, scale);
+    }
+
+    /**
+     * @brief Returns the coefficient, the value without its decimal point.
+     *
+     * @return const bigint& The coefficient
+     */
+    const bigint &unscaled() const
+    {
+        return coeff;
+    }
+
+    /**
+     * @brief Returns the number of digits after the decimal point.
+     *
+     * @return size_t The scale
+     */
+    size_t scale() const
+    {
+        return sc;
+    }
+
+    /**
+     * @brief Converts the bigdecimal to its string representation.
+     *
+     * All digits up to the scale are written, e.g. "-0.0500" for the coefficient
+     * -500 with the scale 4.
+     *
+     * @return std::string The string representation
+     */
+    std::string to_string() const
+    {
+        std::string digits = coeff.to_string(10);
+        std::string sign;
+        if (digits[0] == '-')
+        {
+            sign = "-";
+            digits.erase(0, 1);
+        }
+        if (sc == 0)
+            return sign + digits;
+        if (digits.size() <= sc)
+            digits.insert(0, sc + 1 - digits.size(), '0');
+        return sign + digits.substr(0, digits.size() - sc) + "." + digits.substr(digits.size() - sc);
+    }
+
+    /**
+     * @brief Construct a new bigdecimal object with an initial value of 0.
+     *
+     */
+    bigdecimal() : coeff(0), sc(0) {}
+
+    /**
+     * @brief Construct a new bigdecimal object from a signed 64-bit integer.
+     *
+     * @param value The integer value, with scale 0
+     */
+    bigdecimal(int64_t value) : coeff(value), sc(0) {}
+
+    /**
+     * @brief Construct a new bigdecimal object from a coefficient and a scale.
+     *
+     * @param coefficient The value without its decimal point
+     * @param scale The number of digits after the decimal point
+     */
+    bigdecimal(const bigint &coefficient, size_t scale) : coeff(coefficient), sc(scale) {}
+
+    /**
+     * @brief Construct a new bigdecimal object from a string representation.
+     *
+     * @param str The string representing the number, such as "-123.4500". The
+     * scale is the number of digits after the point, trailing zeros included.
+     */
+    bigdecimal(const std::string &str) : coeff(0), sc(0)
+    {
+        size_t point = str.find('.');
+        if (point == std::string::npos)
+        {
+            coeff = bigint(str);
+            return;
+        }
+        std::string fraction = str.substr(point + 1);
+        if (fraction.empty() || fraction[0] == '-')
+            throw std::invalid_argument("Invalid decimal string!");
+        coeff = bigint(str.substr(0, point) + fraction);
+        sc = fraction.size();
+    }
+
+private:
+    /**
+     * @brief The value without its decimal point.
+     *
+     */
+    bigint coeff;
+
+    /**
+     * @brief The number of digits after the decimal point.
+     *
+     */
+    size_t sc;
+
+    /**
+     * @brief Returns the coefficient at a scale not below the current one.
+     *
+     * @param scale The target scale
+     * @return bigint The coefficient with scale - sc zeros appended
+     */
+    bigint aligned(size_t scale) const
+    {
+        return coeff.shift10(static_cast<int64_t>(scale - sc));
+    }
+
+    /**
+     * @brief Drops low digits of a coefficient and rounds them.
+     *
+     * Only the dropped digits are inspected, so rounding costs no division.
+     *
+     * @param value The coefficient
+     * @param drop The number of low digits to drop (at least 1)
+     * @param mode The rounding mode
+     * @return bigint The rounded coefficient
+     */
+    static bigint round_digits(const bigint &value, size_t drop, rounding_mode mode)
+    {
+        uint8_t first = value.digit(drop - 1);
+        bool sticky = false;
+        for (size_t i = 0; i + 1 < drop && !sticky; ++i)
+            sticky = value.digit(i) != 0;
+
+        bigint kept = value.shift10(-static_cast<int64_t>(drop));
+        bool away = false;
+        switch (mode)
+        {
+        case rounding_mode::half_even:
+            away = first > 5 || (first == 5 && (sticky || kept.digit(0) % 2 == 1));
+            break;
+        case rounding_mode::half_up:
+            away = first >= 5;
+            break;
+        case rounding_mode::toward_zero:
+            away = false;
+            break;
+        }
+        if (away)
+            kept += value < 0 ? bigint(-1) : bigint(1);
+        return kept;
+    }
+};
+
+#endif // BIGDECIMAL_HPP
@@ -0,0 +1,903 @@
+/**
+ * @file bigfloat.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigfloat
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGFLOAT_HPP
+#define BIGFLOAT_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief A class for arbitrary-precision floating-point numbers
+ *
+ * The value is `mantissa * 10^exponent`, with a bigint mantissa of at most
+ * `precision` decimal digits. The radix is 10 because bigint stores decimal
+ * digits, so rounding to a precision only drops digits instead of dividing.
+ *
+ * Every operation returns the correctly rounded result of its exact operands in
+ * the current rounding mode. Operands longer than the result needs are truncated
+ * to a few guard digits first, so no work is spent on digits that would be
+ * discarded; the exact computation is only done when the error bound of the
+ * truncated one straddles a rounding boundary.
+ *
+ */
+class bigfloat
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * @param out an instance of std::ostream
+     * @param num the bigfloat object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const bigfloat &num)
+    {
+        return out << num.to_string();
+    }
+
+public:
+    /**
+     * @brief Rounding modes for results that aren't exactly representable.
+     *
+     * - `nearest_even`: round to nearest, ties to an even last digit
+     * - `toward_zero`: truncate
+     * - `toward_positive`: round up
+     * - `toward_negative`: round down
+     *
+     */
+    enum class rounding_mode
+    {
+        nearest_even,
+        toward_zero,
+        toward_positive,
+        toward_negative
+    };
+
+    /**
+     * @brief Sets the rounding mode used by every operation.
+     *
+     * @param mode The new rounding mode
+     */
+    static void set_rounding_mode(rounding_mode mode)
+    {
+        current_rounding_mode = mode;
+    }
+
+    /**
+     * @brief Returns the rounding mode used by every operation.
+     *
+     * @return rounding_mode The current rounding mode
+     */
+    static rounding_mode get_rounding_mode()
+    {
+        return current_rounding_mode;
+    }
+
+    /**
+     * @brief Sets the precision given to values constructed without an explicit one.
+     *
+     * @param digits The precision in decimal digits (at least 1)
+     */
+    static void set_default_precision(size_t digits)
+    {
+        check_precision(digits);
+        default_precision = digits;
+    }
+
+    /**
+     * @brief Returns the precision given to values constructed without an explicit one.
+     *
+     * @return size_t The precision in decimal digits
+     */
+    static size_t get_default_precision()
+    {
+        return default_precision;
+    }
+
+    /**
+     * @brief Checks if two bigfloat numbers are equal
+     *
+     * @param rhs The bigfloat to compare with
+     * @return true if both bigfloat numbers are equal
+     * @return false otherwise
+     */
+    bool operator==(const bigfloat &rhs) const
+    {
+        return compare(*this, rhs) == 0;
+    }
+
+    /**
+     * @brief Check if two bigfloat numbers are not equal
+     *
+     * @param rhs The bigfloat to compare with
+     * @return true if the bigfloat numbers are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const bigfloat &rhs) const
+    {
+        return compare(*this, rhs) != 0;
+    }
+
+    /**
+     * @brief Compares if the current bigfloat is less than the given bigfloat
+     *
+     * @param rhs The bigfloat to compare with
+     * @return true if the current bigfloat is less than the given bigfloat
+     * @return false otherwise
+     */
+    bool operator<(const bigfloat &rhs) const
+    {
+        return compare(*this, rhs) < 0;
+    }
+
+    /**
+     * @brief Compares if the current bigfloat is less than or equal to the given bigfloat
+     *
+     * @param rhs The bigfloat to compare with
+     * @return true if the current bigfloat is less than or equal to the given bigfloat
+     * @return false otherwise
+     */
+    bool operator<=(const bigfloat &rhs) const
+    {
+        return compare(*this, rhs) <= 0;
+    }
+
+    /**
+     * @brief Compares if the current bigfloat is greater than the given bigfloat
+     *
+     * @param rhs The bigfloat to compare with
+     * @return true if the current bigfloat is greater than the given bigfloat
+     * @return false otherwise
+     */
+    bool operator>(const bigfloat &rhs) const
+    {
+        return compare(*this, rhs) > 0;
+    }
+
+    /**
+     * @brief Compares if the current bigfloat is greater than or equal to the given bigfloat
+     *
+     * @param rhs The bigfloat to compare with
+     * @return true if the current bigfloat is greater than or equal to the given bigfloat
+     * @return false otherwise
+     */
+    bool operator>=(const bigfloat &rhs) const
+    {
+        return compare(*this, rhs) >= 0;
+    }
+
+    /**
+     * @brief Adds two bigfloat numbers, rounded to the larger of their precisions
+     *
+     * @param rhs The bigfloat to add to the current bigfloat
+     * @return bigfloat A new one representing the sum
+     */
+    bigfloat operator+(const bigfloat &rhs) const
+    {
+        return add(*this, rhs, std::max(prec, rhs.prec));
+    }
+
+    /**
+     * @brief Subtracts the given bigfloat, rounded to the larger of both precisions
+     *
+     * @param rhs The bigfloat to subtract
+     * @return bigfloat A new one representing the difference
+     */
+    bigfloat operator-(const bigfloat &rhs) const
+    {
+        return add(*this, -rhs, std::max(prec, rhs.prec));
+    }
+
+    /**
+     * @brief Multiplies two bigfloat numbers, rounded to the larger of their precisions
+     *
+     * @param rhs The bigfloat to multiply with the current bigfloat
+     * @return bigfloat A new one representing the product
+     */
+    bigfloat operator*(const bigfloat &rhs) const
+    {
+        return mul(*this, rhs, std::max(prec, rhs.prec));
+    }
+
+    /**
+     * @brief Divides by the given bigfloat, rounded to the larger of both precisions
+     *
+     * @param rhs The bigfloat divisor
+     * @return bigfloat A new one representing the quotient
+     */
+    bigfloat operator/(const bigfloat &rhs) const
+    {
+        return div(*this, rhs, std::max(prec, rhs.prec));
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return bigfloat& A reference to the current object after the operation
+     */
+    bigfloat &operator+=(const bigfloat &rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return bigfloat& A reference to the current object after the operation
+     */
+    bigfloat &operator-=(const bigfloat &rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return bigfloat& A reference to the current object after the operation
+     */
+    bigfloat &operator*=(const bigfloat &rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment /= overloading
+     *
+     * @param rhs right hand side
+     * @return bigfloat& A reference to the current object after the operation
+     */
+    bigfloat &operator/=(const bigfloat &rhs)
+    {
+        *this = *this / rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return bigfloat A negated bigfloat value
+     */
+    bigfloat operator-() const
+    {
+        bigfloat result(*this);
+        result.m = -result.m;
+        return result;
+    }
+
+    /**
+     * @brief Adds two bigfloat numbers with a given precision.
+     *
+     * Digits more than a few places below the precision of the result are cut off
+     * before aligning, so an operand with a far smaller exponent isn't shifted and
+     * added digit by digit; it only contributes a sticky digit or an error bound.
+     *
+     * @param x The first addend
+     * @param y The second addend
+     * @param precision The precision of the result in decimal digits
+     * @return bigfloat The correctly rounded sum
+     */
+    static bigfloat add(const bigfloat &x, const bigfloat &y, size_t precision)
+    {
+        check_precision(precision);
+        if (x.m == 0)
+            return y.round_to(precision);
+        if (y.m == 0)
+            return x.round_to(precision);
+
+        // Digits below floor can't reach the rounding position unless the sum cancels
+        int64_t top = std::max(x.top(), y.top());
+        int64_t floor = top - static_cast<int64_t>(precision + guard_digits);
+        int64_t low = std::min(x.e, y.e);
+        if (low >= floor)
+            return rounded(x.m.shift10(x.e - low) + y.m.shift10(y.e - low), low, precision);
+
+        bigint tx = x.m.shift10(std::min<int64_t>(x.e - floor, 0));
+        bigint ty = y.m.shift10(std::min<int64_t>(y.e - floor, 0));
+        bool lost_x = x.e < floor && tx.shift10(floor - x.e) != x.m;
+        bool lost_y = y.e < floor && ty.shift10(floor - y.e) != y.m;
+        bigint sum = tx.shift10(std::max<int64_t>(x.e - floor, 0)) + ty.shift10(std::max<int64_t>(y.e - floor, 0));
+
+        // If only an operand at least two places below the other one lost digits, the sum
+        // keeps its leading digit and the lost part can only act as a sticky digit
+        const bigfloat &small = x.top() < y.top() ? x : y;
+        bool lost_small = x.top() < y.top() ? lost_x : lost_y;
+        bool lost_large = x.top() < y.top() ? lost_y : lost_x;
+        if (!lost_large && small.top() <= top - 2)
+        {
+            sum = sum.shift10(1);
+            if (lost_small)
+                sum += small.m < 0 ? bigint(-1) : bigint(1);
+            return rounded(sum, floor - 1, precision);
+        }
+
+        bigint error(static_cast<int64_t>(lost_x) + static_cast<int64_t>(lost_y));
+        bigfloat result;
+        if (round_bounds(sum - error, sum + error, floor, precision, result))
+            return result;
+        return rounded(x.m.shift10(x.e - low) + y.m.shift10(y.e - low), low, precision);
+    }
+
+    /**
+     * @brief Multiplies two bigfloat numbers with a given precision.
+     *
+     * Operands longer than the precision plus a few guard digits are truncated
+     * before multiplying. The product of the truncated operands comes with an error
+     * bound, and the exact product is only computed if that bound straddles a
+     * rounding boundary.
+     *
+     * @param x The first factor
+     * @param y The second factor
+     * @param precision The precision of the result in decimal digits
+     * @return bigfloat The correctly rounded product
+     */
+    static bigfloat mul(const bigfloat &x, const bigfloat &y, size_t precision)
+    {
+        check_precision(precision);
+        int64_t kx = excess_digits(x.m, precision + guard_digits);
+        int64_t ky = excess_digits(y.m, precision + guard_digits);
+        if (kx > 0 || ky > 0)
+        {
+            // (a + ra)(b + rb) - ab = a rb + b ra + ra rb, with |ra|, |rb| below one unit
+            bigint a = x.m.shift10(-kx);
+            bigint b = y.m.shift10(-ky);
+            bigint product = a * b;
+            bigint error = (ky > 0 ? magnitude(a) : bigint(0)) + (kx > 0 ? magnitude(b) : bigint(0)) + bigint(kx > 0 && ky > 0 ? 1 : 0);
+            bigfloat result;
+            if (round_bounds(product - error, product + error, x.e + kx + y.e + ky, precision, result))
+                return result;
+        }
+        return rounded(x.m * y.m, x.e + y.e, precision);
+    }
+
+    /**
+     * @brief Divides two bigfloat numbers with a given precision.
+     *
+     * Like mul(), operands longer than needed are truncated first, and the quotient
+     * is bracketed by the quotients of the truncated bounds.
+     *
+     * @param x The dividend
+     * @param y The divisor
+     * @param precision The precision of the result in decimal digits
+     * @return bigfloat The correctly rounded quotient
+     */
+    static bigfloat div(const bigfloat &x, const bigfloat &y, size_t precision)
+    {
+        check_precision(precision);
+        if (y.m == 0)
+            throw std::invalid_argument("Division by zero");
+        if (x.m == 0)
+            return rounded(bigint(0), 0, precision);
+        bool negative = (x.m < 0) != (y.m < 0);
+
+        int64_t kx = excess_digits(x.m, precision + guard_digits);
+        int64_t ky = excess_digits(y.m, precision + guard_digits);
+        if (kx > 0 || ky > 0)
+        {
+            // |x| lies in [a, a + 1) and |y| in [b, b + 1) units of the truncated operands
+            bigint a = magnitude(x.m.shift10(-kx));
+            bigint b = magnitude(y.m.shift10(-ky));
+            int64_t scale = quotient_scale(a, b, precision + guard_digits);
+            bigint b_high = ky > 0 ? b + bigint(1) : b;
+            bigint low = a.shift10(scale) / b_high;
+            bigint high = ((kx > 0 ? a + bigint(1) : a).shift10(scale) + b - bigint(1)) / b;
+            int64_t exponent = x.e + kx - y.e - ky - scale;
+            bigfloat result;
+            if (negative ? round_bounds(-high, -low, exponent, precision, result)
+                         : round_bounds(low, high, exponent, precision, result))
+                return result;
+        }
+
+        // Scale the dividend so the quotient has at least precision + 1 digits
+        int64_t scale = quotient_scale(x.m, y.m, precision + 1);
+        bigint dividend = x.m.shift10(scale);
+        bigint quotient = dividend / y.m;
+
+        // A non-zero remainder becomes a sticky digit below the quotient
+        quotient = quotient.shift10(1);
+        if (quotient * y.m != dividend.shift10(1))
+            quotient += negative ? bigint(-1) : bigint(1);
+        return rounded(quotient, x.e - y.e - scale - 1, precision);
+    }
+
+    /**
+     * @brief Computes the square root of a bigfloat number with a given precision.
+     *
+     * A radicand longer than needed is truncated first and the root bracketed by
+     * the roots of the truncated bounds, like in mul().
+     *
+     * @param x The radicand, must not be negative
+     * @param precision The precision of the result in decimal digits
+     * @return bigfloat The correctly rounded square root
+     */
+    static bigfloat sqrt(const bigfloat &x, size_t precision)
+    {
+        check_precision(precision);
+        if (x.m < 0)
+            throw std::invalid_argument("Square root of a negative number");
+        if (x.m == 0)
+            return rounded(bigint(0), 0, precision);
+
+        int64_t kx = excess_digits(x.m, 2 * (precision + guard_digits));
+        if (kx > 0)
+        {
+            bigint a = x.m.shift10(-kx);
+            int64_t scale = root_scale(a, x.e + kx, precision + guard_digits);
+            bigint low = isqrt(a.shift10(scale));
+            bigint high = isqrt((a + bigint(1)).shift10(scale)) + bigint(1);
+            bigfloat result;
+            if (round_bounds(low, high, (x.e + kx - scale) / 2, precision, result))
+                return result;
+        }
+
+        int64_t scale = root_scale(x.m, x.e, precision + 1);
+        bigint radicand = x.m.shift10(scale);
+        bigint root = isqrt(radicand);
+
+        // An inexact root becomes a sticky digit below it
+        root = root.shift10(1);
+        if (root * root != radicand.shift10(2))
+            root += bigint(1);
+        return rounded(root, (x.e - scale) / 2 - 1, precision);
+    }
+
+    /**
+     * @brief Computes the square root with the precision of the current bigfloat.
+     *
+     * @return bigfloat The correctly rounded square root
+     */
+    bigfloat sqrt() const
+    {
+        return sqrt(*this, prec);
+    }
+
+    /**
+     * @brief Returns the value rounded to another precision.
+     *
+     * @param precision The new precision in decimal digits
+     * @return bigfloat The rounded value carrying the new precision
+     */
+    bigfloat round_to(size_t precision) const
+    {
+        check_precision(precision);
+        if (m.digits() <= precision)
+        {
+            bigfloat result(*this);
+            result.prec = precision;
+            return result;
+        }
+        return rounded(m, e, precision);
+    }
+
+    /**
+     * @brief Returns the precision of the bigfloat in decimal digits.
+     *
+     * @return size_t The precision
+     */
+    size_t precision() const
+    {
+        return prec;
+    }
+
+    /**
+     * @brief Returns the mantissa, without trailing zeros.
+     *
+     * @return const bigint& The mantissa, carrying the sign of the value
+     */
+    const bigint &mantissa() const
+    {
+        return m;
+    }
+
+    /**
+     * @brief Returns the decimal exponent, the value being mantissa * 10^exponent.
+     *
+     * @return int64_t The exponent
+     */
+    int64_t exponent() const
+    {
+        return e;
+    }
+
+    /**
+     * @brief Converts the bigfloat to a bigint, truncating toward zero.
+     *
+     * @return bigint The integer part
+     */
+    bigint to_bigint() const
+    {
+        return m.shift10(e);
+    }
+
+    /**
+     * @brief Converts the bigfloat to its string representation.
+     *
+     * The mantissa digits are written in scientific notation, e.g. "-1.25e-3";
+     * the exponent is left out when it is zero.
+     *
+     * @return std::string The string representation
+     */
+    std::string to_string() const
+    {
+        std::string digits = m.to_string(10);
+        std::string sign;
+        if (digits[0] == '-')
+        {
+            sign = "-";
+            digits.erase(0, 1);
+        }
+
+        int64_t scientific = e + static_cast<int64_t>(digits.size()) - 1;
+        std::string result = sign + digits.substr(0, 1);
+        if (digits.size() > 1)
+            result += "." + digits.substr(1);
+        if (scientific != 0 && m != 0)
+            result += "e" + std::to_string(scientific);
+        return result;
+    }
+
+    /**
+     * @brief Construct a new bigfloat object with an initial value of 0.
+     *
+     */
+    bigfloat() : m(0), e(0), prec(default_precision) {}
+
+    /**
+     * @brief Construct a new bigfloat object from a signed 64-bit integer.
+     *
+     * @param value The integer value
+     * @param precision The precision in decimal digits
+     */
+    bigfloat(int64_t value, size_t precision = default_precision) : bigfloat(bigint(value), 0, precision) {}
+
+    /**
+     * @brief Construct a new bigfloat object from a bigint.
+     *
+     * @param value The integer value
+     * @param precision The precision in decimal digits
+     */
+    bigfloat(const bigint &value, size_t precision = default_precision) : bigfloat(value, 0, precision) {}
+
+    /**
+     * @brief Construct a new bigfloat object with the value mantissa * 10^exponent.
+     *
+     * @param mantissa The mantissa
+     * @param exponent The decimal exponent
+     * @param precision The precision in decimal digits
+     */
+    bigfloat(const bigint &mantissa, int64_t exponent, size_t precision)
+    {
+        check_precision(precision);
+        *this = rounded(mantissa, exponent, precision);
+    }
+
+    /**
+     * @brief Construct a new bigfloat object from a string representation.
+     *
+     * @param str The string representing the number, such as "-12.5", "3e10" or
+     * "1.25E-3". The decimal value is rounded once to the precision.
+     * @param precision The precision in decimal digits
+     */
+    bigfloat(const std::string &str, size_t precision = default_precision)
+    {
+        check_precision(precision);
+
+        size_t index = 0;
+        std::string sign;
+        if (!str.empty() && (str[0] == '-' || str[0] == '+'))
+        {
+            if (str[0] == '-')
+                sign = "-";
+            index = 1;
+        }
+
+        // Collect the integer and fraction digits into one mantissa
+        std::string digits;
+        int64_t exponent = 0;
+        bool point = false;
+        for (; index < str.size() && str[index] != 'e' && str[index] != 'E'; ++index)
+        {
+            if (str[index] == '.' && !point)
+                point = true;
+            else if (std::isdigit(static_cast<unsigned char>(str[index])))
+            {
+                digits.push_back(str[index]);
+                if (point)
+                    --exponent;
+            }
+            else
+                throw std::invalid_argument("Invalid floating-point string!");
+        }
+        if (digits.empty())
+            throw std::invalid_argument("Invalid floating-point string!");
+
+        if (index < str.size())
+        {
+            std::string power = str.substr(index + 1);
+            size_t start = !power.empty() && (power[0] == '-' || power[0] == '+') ? 1 : 0;
+            if (power.size() == start || power.find_first_not_of("0123456789", start) != std::string::npos)
+                throw std::invalid_argument("Invalid floating-point string!");
+            exponent += std::stoll(power);
+        }
+
+        *this = rounded(bigint(sign + digits), exponent, precision);
+    }
+
+private:
+    /**
+     * @brief The mantissa, without trailing zeros, carrying the sign of the value.
+     *
+     */
+    bigint m;
+
+    /**
+     * @brief The decimal exponent.
+     *
+     */
+    int64_t e;
+
+    /**
+     * @brief The precision in decimal digits.
+     *
+     */
+    size_t prec;
+
+    /**
+     * @brief The rounding mode used by every operation.
+     *
+     */
+    inline static rounding_mode current_rounding_mode = rounding_mode::nearest_even;
+
+    /**
+     * @brief The precision given to values constructed without an explicit one.
+     *
+     */
+    inline static size_t default_precision = 50;
+
+    /**
+     * @brief Digits kept beyond the precision when operands are truncated.
+     *
+     */
+    static constexpr size_t guard_digits = 3;
+
+    /**
+     * @brief Throws for a precision of zero digits.
+     *
+     * @param precision The precision to check
+     */
+    static void check_precision(size_t precision)
+    {
+        if (precision == 0)
+            throw std::invalid_argument("Precision must be at least one digit.");
+    }
+
+    /**
+     * @brief Returns the exponent just above the most significant mantissa digit.
+     *
+     * @return int64_t The exponent e such that |value| < 10^e
+     */
+    int64_t top() const
+    {
+        return e + static_cast<int64_t>(m.digits());
+    }
+
+    /**
+     * @brief Compares two bigfloat numbers exactly.
+     *
+     * @param a The first number
+     * @param b The second number
+     * @return int -1, 0 or 1 as a is less than, equal to or greater than b
+     */
+    static int compare(const bigfloat &a, const bigfloat &b)
+    {
+        int sa = a.m < 0 ? -1 : (a.m == 0 ? 0 : 1);
+        int sb = b.m < 0 ? -1 : (b.m == 0 ? 0 : 1);
+        if (sa != sb)
+            return sa < sb ? -1 : 1;
+        if (sa == 0)
+            return 0;
+
+        // Mantissas have no trailing zeros, so the leading digit position orders them
+        if (a.top() != b.top())
+            return (a.top() > b.top()) == (sa > 0) ? 1 : -1;
+
+        int64_t low = std::min(a.e, b.e);
+        bigint am = a.m.shift10(a.e - low);
+        bigint bm = b.m.shift10(b.e - low);
+        return am < bm ? -1 : (am == bm ? 0 : 1);
+    }
+
+    /**
+     * @brief Returns the absolute value of a bigint.
+     *
+     * @param value The value
+     * @return bigint The absolute value
+     */
+    static bigint magnitude(const bigint &value)
+    {
+        return value < 0 ? -value : value;
+    }
+
+    /**
+     * @brief Returns how many digits a mantissa has beyond a given length.
+     *
+     * @param mantissa The mantissa
+     * @param keep The number of digits to keep
+     * @return int64_t The number of excess digits, 0 if the mantissa is short enough
+     */
+    static int64_t excess_digits(const bigint &mantissa, size_t keep)
+    {
+        return mantissa.digits() > keep ? static_cast<int64_t>(mantissa.digits() - keep) : 0;
+    }
+
+    /**
+     * @brief Returns the power of ten that gives a / b at least the given number of digits.
+     *
+     * @param a The dividend
+     * @param b The divisor
+     * @param digits The minimum number of quotient digits
+     * @return int64_t The non-negative scale of the dividend
+     */
+    static int64_t quotient_scale(const bigint &a, const bigint &b, size_t digits)
+    {
+        int64_t scale = static_cast<int64_t>(digits + b.digits()) - static_cast<int64_t>(a.digits());
+        return std::max<int64_t>(scale, 0);
+    }
+
+    /**
+     * @brief Returns the power of ten that gives sqrt(a) at least the given number of digits.
+     *
+     * The scale also makes the exponent of the scaled radicand even.
+     *
+     * @param a The radicand mantissa
+     * @param exponent The radicand exponent
+     * @param digits The minimum number of root digits
+     * @return int64_t The non-negative scale of the radicand
+     */
+    static int64_t root_scale(const bigint &a, int64_t exponent, size_t digits)
+    {
+        int64_t scale = static_cast<int64_t>(2 * digits) - static_cast<int64_t>(a.digits());
+        scale = std::max<int64_t>(scale, 0);
+        if ((exponent - scale) % 2 != 0)
+            ++scale;
+        return scale;
+    }
+
+    /**
+     * @brief Rounds a value only known to lie between two bounds, if the bounds agree.
+     *
+     * Rounding is monotonic, so when both bounds round to the same value, so does
+     * everything between them.
+     *
+     * @param low The lower bound of the mantissa
+     * @param high The upper bound of the mantissa
+     * @param exponent The decimal exponent of both bounds
+     * @param precision The precision in decimal digits
+     * @param result Receives the rounded value if the bounds agree
+     * @return true if the bounds round to the same value
+     * @return false otherwise
+     */
+    static bool round_bounds(const bigint &low, const bigint &high, int64_t exponent, size_t precision, bigfloat &result)
+    {
+        bigfloat a = rounded(low, exponent, precision);
+        bigfloat b = rounded(high, exponent, precision);
+        if (compare(a, b) != 0)
+            return false;
+        result = a;
+        return true;
+    }
+
+    /**
+     * @brief Decides whether a truncated mantissa must be rounded away from zero.
+     *
+     * @param first The most significant discarded digit
+     * @param sticky Whether any other discarded digit is non-zero
+     * @param odd Whether the last kept digit is odd
+     * @param negative Whether the value is negative
+     * @return true if the magnitude must be incremented
+     * @return false otherwise
+     */
+    static bool round_away(uint8_t first, bool sticky, bool odd, bool negative)
+    {
+        if (first == 0 && !sticky)
+            return false;
+        switch (current_rounding_mode)
+        {
+        case rounding_mode::nearest_even:
+            return first > 5 || (first == 5 && (sticky || odd));
+        case rounding_mode::toward_zero:
+            return false;
+        case rounding_mode::toward_positive:
+            return !negative;
+        case rounding_mode::toward_negative:
+            return negative;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Rounds mantissa * 10^exponent to a precision in the current rounding mode.
+     *
+     * @param mantissa The exact mantissa
+     * @param exponent The decimal exponent
+     * @param precision The precision in decimal digits
+     * @return bigfloat The rounded value, without trailing zeros in the mantissa
+     */
+    static bigfloat rounded(bigint mantissa, int64_t exponent, size_t precision)
+    {
+        bigfloat result;
+        result.prec = precision;
+        if (mantissa == 0)
+            return result;
+
+        size_t digits = mantissa.digits();
+        if (digits > precision)
+        {
+            size_t drop = digits - precision;
+            bool sticky = false;
+            for (size_t i = 0; i + 1 < drop && !sticky; ++i)
+                sticky = mantissa.digit(i) != 0;
+            bool negative = mantissa < 0;
+            uint8_t first = mantissa.digit(drop - 1);
+
+            mantissa = mantissa.shift10(-static_cast<int64_t>(drop));
+            exponent += static_cast<int64_t>(drop);
+            if (round_away(first, sticky, mantissa.digit(0) % 2 == 1, negative))
+            {
+                mantissa += negative ? bigint(-1) : bigint(1);
+                // 99...9 rounded up to 100...0 has one digit too many
+                if (mantissa.digits() > precision)
+                {
+                    mantissa = mantissa.shift10(-1);
+                    ++exponent;
+                }
+            }
+        }
+
+        // Strip trailing zeros so the mantissa stays as short as possible
+        size_t zeros = 0;
+        while (mantissa.digit(zeros) == 0)
+            ++zeros;
+        result.m = mantissa.shift10(-static_cast<int64_t>(zeros));
+        result.e = exponent + static_cast<int64_t>(zeros);
+        return result;
+    }
+
+    /**
+     * @brief Computes floor(sqrt(n)) with Newton's iteration.
+     *
+     * @param n The positive radicand
+     * @return bigint The integer square root
+     */
+    static bigint isqrt(const bigint &n)
+    {
+        // 10^ceil(digits / 2) is above the root
+        bigint guess = bigint(1).shift10(static_cast<int64_t>((n.digits() + 1) / 2));
+        while (true)
+        {
+            bigint next = (guess + n / guess) / bigint(2);
+            if (next >= guess)
+                return guess;
+            guess = std::move(next);
+        }
+    }
+};
+
+#endif // BIGFLOAT_HPP
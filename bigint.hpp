@@ -8,10 +8,25 @@
  * @copyright Copyright (c) 2024
  *
  */
+#ifndef BIGINT_HPP
+#define BIGINT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <random>
+#include <type_traits>
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include <utility>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 /**
  * @brief A class for arbitrary-precision integers
@@ -28,20 +43,34 @@ class bigint
      */
     friend std::ostream &operator<<(std::ostream &out, const bigint &num)
     {
-        // If the number is negative, output the minus sign
-        if (num.is_negative)
-            out << '-';
+        // Write the digits from the most significant in chunks, rather than a character at a time
+        return num.write(out);
+    }
 
-        // Iterate through the digits stored in the vector in reversed order
-        // from the most significant to the least significant digit
-        for (size_t i = num.vec.size(); i > 0; --i)
+    /**
+     * @brief Loads the digits of files straight into the digit vectors, without a copy.
+     *
+     */
+    friend class bigint_file;
 
-            // Convert each digit to a character and output it
-            out << static_cast<char>('0' + num.vec[i - 1]);
+    /**
+     * @brief Reads the digit vectors of the values it sums, and builds its total from digits.
+     *
+     */
+    friend class bigint_accumulator;
 
-        // Return the stream
-        return out;
-    }
+    /**
+     * @brief Copy the digits of arena and disk values straight into a digit vector.
+     *
+     */
+    friend class bigint_arena;
+    friend class disk_bigint;
+
+    /**
+     * @brief Packs and unpacks Kronecker slots straight between digit vectors.
+     *
+     */
+    friend class bigint_poly;
 
 public:
     /**
@@ -180,24 +209,8 @@ public:
      */
     bigint operator*(const bigint &rhs) const
     {
-        // Initialize a vector to hold the product
-        // It's properly sized for maximum possible digits
-        std::vector<uint8_t> product(vec.size() + rhs.vec.size(), 0);
-
-        // Perform digit-by-digit multiplication
-        for (size_t i = 0; i < vec.size(); ++i)
-        {
-            int carry = 0;
-            for (size_t j = 0; j < rhs.vec.size() || carry; ++j)
-            {
-                int64_t current = product[i + j] + vec[i] * (j < rhs.vec.size() ? rhs.vec[j] : 0) + carry;
-                product[i + j] = static_cast<uint8_t>(current % 10);
-                carry = static_cast<uint8_t>(current / 10);
-            }
-        }
-
         // Determine the sign of the product and return the result
-        return bigint(is_negative != rhs.is_negative, product);
+        return bigint(is_negative != rhs.is_negative, multiply_vec(vec, rhs.vec));
     }
 
     /**
@@ -212,14 +225,9 @@ public:
         if (rhs == 0)
             throw std::invalid_argument("Division by zero");
 
-        // Make both dividend and divisor positive for calculation
-        bigint dividend(*this);
-        bigint divisor(rhs);
-        dividend.is_negative = false;
-        divisor.is_negative = false;
-
+        // Work on the absolute values, comparing and subtracting the digits directly
         // If the divisor is greater than the dividend, the result is zero
-        if (abs_compare(dividend.vec, divisor.vec) < 0)
+        if (abs_compare(vec, rhs.vec) < 0)
             return bigint(0);
 
         // Initialize variables for the quotient and the current value being divided
@@ -227,15 +235,16 @@ public:
         bigint current(0);
 
         // Perform long division
-        for (size_t i = dividend.vec.size(); i > 0; --i)
+        for (size_t i = vec.size(); i > 0; --i)
         {
-            current.vec.insert(current.vec.begin(), dividend.vec[i - 1]);
+            current.vec.insert(current.vec.begin(), vec[i - 1]);
             current.trim();
 
             uint8_t count = 0;
-            while (current >= divisor)
+            while (abs_compare(current.vec, rhs.vec) >= 0)
             {
-                current -= divisor;
+                subtract_in_place(current.vec, rhs.vec);
+                current.trim();
                 ++count;
             }
             quotient.push_back(count);
@@ -258,25 +267,23 @@ public:
         if (rhs == 0)
             throw std::invalid_argument("Modulus by zero");
 
-        // Make both dividend and divisor positive for calculation
-        bigint dividend(*this);
-        bigint divisor(rhs);
-        dividend.is_negative = false;
-        divisor.is_negative = false;
-
+        // Work on the absolute values, comparing and subtracting the digits directly
         // If the dividend is smaller than the divisor, return the dividend
-        if (dividend < divisor)
+        if (abs_compare(vec, rhs.vec) < 0)
             return *this;
 
         // Perform modulus operation
         bigint current(0);
-        for (size_t i = dividend.vec.size(); i > 0; --i)
+        for (size_t i = vec.size(); i > 0; --i)
         {
-            current.vec.insert(current.vec.begin(), dividend.vec[i - 1]);
+            current.vec.insert(current.vec.begin(), vec[i - 1]);
             current.trim();
 
-            while (current >= divisor)
-                current -= divisor;
+            while (abs_compare(current.vec, rhs.vec) >= 0)
+            {
+                subtract_in_place(current.vec, rhs.vec);
+                current.trim();
+            }
         }
 
         // Set the correct sign for the remainder
@@ -295,7 +302,7 @@ public:
      */
     bigint &operator+=(const bigint &rhs)
     {
-        *this = *this + rhs;
+        add_in_place(rhs, rhs.is_negative);
         return *this;
     }
 
@@ -307,7 +314,7 @@ public:
      */
     bigint &operator-=(const bigint &rhs)
     {
-        *this = *this - rhs;
+        add_in_place(rhs, !rhs.is_negative);
         return *this;
     }
 
@@ -375,8 +382,9 @@ public:
      */
     bigint operator++(int)
     {
-        bigint temp = *this;
-        *this = *this + 1;
+        // The old digits are moved out rather than copied, the sum needs new ones anyway
+        bigint temp = std::move(*this);
+        *this = temp + 1;
         return temp;
     }
 
@@ -398,8 +406,8 @@ public:
      */
     bigint operator--(int)
     {
-        bigint temp = *this;
-        *this = *this - 1;
+        bigint temp = std::move(*this);
+        *this = temp - 1;
         return temp;
     }
 
@@ -414,53 +422,645 @@ public:
      * @return std::string The string representation of the bigint in the specified base.
      */
     std::string to_string(uint64_t base) const
+    {
+        std::string result;
+        write_digits([&](const char *data, size_t size)
+                     { result.append(data, size); },
+                     base);
+        return result;
+    }
+
+    /**
+     * @brief Passes the representation in the specified base to a callback, in order and in chunks.
+     *
+     * The characters are produced from the most significant, '-' first for a
+     * negative value, and passed to `sink(const char *data, size_t size)` in
+     * chunks of at most `chunk` characters, so at most one chunk of the text
+     * exists at a time. Decimal digits are written straight from the digit
+     * vector, so the first chunk reaches the sink before the later digits are
+     * read. Other bases first convert the value to 64-bit words, which takes
+     * about half a byte per decimal digit; a power-of-two base is then read
+     * from the top word down, and other bases are divided out a word at a time.
+     *
+     * @tparam Sink A callable taking (const char *, size_t)
+     * @param sink The callback receiving the characters
+     * @param base The base of the representation (must be between 2 and 36), as for to_string()
+     * @param chunk The largest number of characters per call, at least 1
+     */
+    template <typename Sink>
+    void write_digits(Sink &&sink, uint64_t base = 10, size_t chunk = 65536) const
     {
         if (base < 2 || base > 36)
-        {
             throw std::invalid_argument("Base must be between 2 and 36.");
-        }
+        constexpr const char(&symbols)[37] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+        // No representation is longer than four characters per decimal digit, plus the sign
+        std::vector<char> buffer(std::max<size_t>(std::min(chunk, 2 + 4 * vec.size()), 1));
+        size_t used = 0;
+        auto put = [&](char c)
+        {
+            if (used == buffer.size())
+            {
+                sink(static_cast<const char *>(buffer.data()), used);
+                used = 0;
+            }
+            buffer[used++] = c;
+        };
 
         if (vec.empty() || (vec.size() == 1 && vec[0] == 0))
+            put('0');
+        else
         {
-            // Return "0" if the number is zero
-            return "0";
+            if (is_negative)
+                put('-');
+            if (base == 10)
+                for (size_t i = vec.size(); i > 0; --i)
+                    put(static_cast<char>('0' + vec[i - 1]));
+            else if ((base & (base - 1)) == 0)
+            {
+                // Every digit is a run of bits, read from the top of the binary words
+                std::vector<uint64_t> words = to_words();
+                size_t width = 0;
+                while ((uint64_t(1) << width) < base)
+                    ++width;
+                size_t bits = 64 * words.size();
+                for (uint64_t top = words.back(); (top & (uint64_t(1) << 63)) == 0; top <<= 1)
+                    --bits;
+                for (size_t position = (bits + width - 1) / width * width; position > 0; position -= width)
+                {
+                    size_t low = position - width;
+                    uint64_t value = words[low / 64] >> (low % 64);
+                    if (low % 64 + width > 64 && low / 64 + 1 < words.size())
+                        value |= words[low / 64 + 1] << (64 - low % 64);
+                    put(symbols[value & (base - 1)]);
+                }
+            }
+            else
+            {
+                // Divide out the largest power of the base below 2^64 at a time; the
+                // remainders give the digits in groups, from the least significant group
+                std::vector<uint64_t> words = to_words();
+                uint64_t divisor = base;
+                size_t group = 1;
+                while (divisor <= UINT64_MAX / base)
+                {
+                    divisor *= base;
+                    ++group;
+                }
+                std::vector<uint64_t> groups;
+                groups.reserve(words.size() + 1);
+                while (!words.empty())
+                {
+                    uint64_t remainder = 0;
+                    for (size_t i = words.size(); i > 0; --i)
+                        words[i - 1] = divide_wide(remainder, words[i - 1], divisor, remainder);
+                    while (!words.empty() && words.back() == 0)
+                        words.pop_back();
+                    groups.push_back(remainder);
+                }
+
+                // Groups below the most significant one are padded with zeros
+                char text[64];
+                for (size_t g = groups.size(); g > 0; --g)
+                {
+                    size_t count = 0, width = g == groups.size() ? 1 : group;
+                    for (uint64_t value = groups[g - 1]; value != 0 || count < width; value /= base)
+                        text[count++] = symbols[value % base];
+                    while (count > 0)
+                        put(text[--count]);
+                }
+            }
         }
+        sink(static_cast<const char *>(buffer.data()), used);
+    }
 
-        // Create a copy of the current bigint to work on
-        bigint temp = *this;
-        // Ignore sign for digit extraction
-        temp.is_negative = false;
+    /**
+     * @brief Writes the representation in the specified base to a stream, in order and in chunks.
+     *
+     * @param out The stream
+     * @param base The base of the representation (must be between 2 and 36), as for to_string()
+     * @return std::ostream& The same stream
+     */
+    std::ostream &write(std::ostream &out, uint64_t base = 10) const
+    {
+        write_digits([&](const char *data, size_t size)
+                     { out.write(data, static_cast<std::streamsize>(size)); },
+                     base);
+        return out;
+    }
 
-        std::string result;
+    /**
+     * @brief Returns the number of decimal digits of the absolute value.
+     *
+     * Zero has one digit.
+     *
+     * @return size_t The number of digits
+     */
+    size_t digits() const
+    {
+        return vec.size();
+    }
+
+    /**
+     * @brief Returns the sign of the bigint.
+     *
+     * @return int -1 for a negative value, 0 for zero and 1 for a positive value
+     */
+    int sign() const
+    {
+        if (is_negative)
+            return -1;
+        return vec.size() == 1 && vec[0] == 0 ? 0 : 1;
+    }
 
-        // Characters used for digits in bases up to 36
-        // Pointer seems to work here too:
-        // const char *digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-        // However, for avoiding using pointer, we'll use reference instead:
-        constexpr const char(&digits)[37] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    /**
+     * @brief Returns a decimal digit of the absolute value.
+     *
+     * @param i The position of the digit, 0 being the least significant one
+     * @return uint8_t The digit, or 0 past the most significant digit
+     */
+    uint8_t digit(size_t i) const
+    {
+        return i < vec.size() ? vec[i] : 0;
+    }
 
-        // Convert the number to the desired base
-        // Until the number becomes zero
-        while (!(temp.vec.size() == 1 && temp.vec[0] == 0))
+    /**
+     * @brief Multiplies or divides the bigint by a power of ten.
+     *
+     * Since the digits are stored in base 10, this only inserts or drops digits at
+     * the low end. Division truncates toward zero, like operator/.
+     *
+     * @param k The power of ten, multiplying for k > 0 and dividing for k < 0
+     * @return bigint A new one representing the value times 10^k
+     */
+    bigint shift10(int64_t k) const
+    {
+        if (k == 0 || (vec.size() == 1 && vec[0] == 0))
+            return *this;
+
+        std::vector<uint8_t> result;
+        if (k > 0)
+        {
+            result.reserve(vec.size() + static_cast<size_t>(k));
+            result.assign(static_cast<size_t>(k), 0);
+            result.insert(result.end(), vec.begin(), vec.end());
+        }
+        else
         {
-            bigint remainder(0);
-            temp = temp.divide_by_base(base, remainder);
+            size_t drop = static_cast<size_t>(-(k + 1)) + 1;
+            if (drop >= vec.size())
+                return bigint(0);
+            result.assign(vec.begin() + static_cast<std::ptrdiff_t>(drop), vec.end());
+        }
+        return bigint(is_negative, std::move(result));
+    }
+
+    /**
+     * @brief Returns the low k digits of the bigint.
+     *
+     * This is the remainder of the division by 10^k, with the sign of the dividend
+     * like operator%, so `x == x.shift10(-k).shift10(k) + x.low_digits(k)`. It only
+     * copies digits.
+     *
+     * @param k The number of digits to keep
+     * @return bigint A new one representing the value modulo 10^k
+     */
+    bigint low_digits(size_t k) const
+    {
+        if (k == 0)
+            return bigint(0);
+        if (k >= vec.size())
+            return *this;
+        return bigint(is_negative, std::vector<uint8_t>(vec.begin(), vec.begin() + static_cast<std::ptrdiff_t>(k)));
+    }
 
-            // Remainder will always be less than the base
-            int rem_value = remainder.vec[0];
-            result.push_back(digits[rem_value]);
+    /**
+     * @brief Adds the product of two bigint numbers to the current bigint.
+     *
+     * Equivalent to `*this += a * b`, but the product is added into the digits
+     * of the current bigint in place instead of going through a temporary bigint
+     * and a freshly allocated sum, which suits dot products and other
+     * accumulation loops.
+     *
+     * @param a The first factor
+     * @param b The second factor
+     * @return bigint& A reference to the current object after the operation
+     */
+    bigint &addmul(const bigint &a, const bigint &b)
+    {
+        std::vector<uint8_t> product = multiply_vec(a.vec, b.vec);
+        while (product.size() > 1 && product.back() == 0)
+            product.pop_back();
+        bool product_negative = a.is_negative != b.is_negative;
+
+        if (product.size() == 1 && product[0] == 0)
+            return *this;
+        if (vec.size() == 1 && vec[0] == 0)
+        {
+            vec = std::move(product);
+            is_negative = product_negative;
+            return *this;
         }
 
-        // Reverse the result string as digits were obtained in reverse order
-        std::reverse(result.begin(), result.end());
+        if (product_negative == is_negative)
+        {
+            if (vec.size() < product.size())
+                vec.resize(product.size(), 0);
+            vec.push_back(0);
+            add_shifted(vec, product, 0);
+        }
+        else if (abs_compare(vec, product) >= 0)
+        {
+            subtract_in_place(vec, product);
+        }
+        else
+        {
+            subtract_in_place(product, vec);
+            vec = std::move(product);
+            is_negative = product_negative;
+        }
+        trim();
+        return *this;
+    }
 
-        // Add '-' sign if the original number was negative
-        if (is_negative)
+    /**
+     * @brief Computes the greatest common divisor of two bigint numbers.
+     *
+     * Uses Euclid's algorithm on the absolute values. The result is non-negative,
+     * and gcd(0, 0) is 0.
+     *
+     * @param a The first number
+     * @param b The second number
+     * @return bigint The greatest common divisor
+     */
+    static bigint gcd(bigint a, bigint b)
+    {
+        a.is_negative = false;
+        b.is_negative = false;
+        while (!(b.vec.size() == 1 && b.vec[0] == 0))
         {
-            result = "-" + result;
+            bigint r = a % b;
+            a = std::move(b);
+            b = std::move(r);
         }
+        return a;
+    }
 
-        return result;
+    /**
+     * @brief Returns a hash of the bigint.
+     *
+     * Hashes the digit array and the sign eight bytes at a time with a wyhash-style
+     * multiply-fold, in four independent lanes for long values. Equal values have
+     * equal hashes, and the hash of a value that fits in int64_t is the one
+     * hash(int64_t) gives. The result isn't stable across versions or platforms.
+     *
+     * @return size_t The hash
+     */
+    size_t hash() const
+    {
+        return static_cast<size_t>(hash_digits(vec.data(), vec.size(), is_negative));
+    }
+
+    /**
+     * @brief Returns the hash of bigint(num) without constructing it.
+     *
+     * @param num The signed 64-bit integer
+     * @return size_t The hash
+     */
+    static size_t hash(int64_t num)
+    {
+        uint8_t digits[20];
+        size_t count = int64_digits(num, digits);
+        return static_cast<size_t>(hash_digits(digits, count, num < 0));
+    }
+
+    /**
+     * @brief Checks if the bigint equals a signed 64-bit integer without constructing it.
+     *
+     * @param num The signed 64-bit integer to compare with
+     * @return true if both values are equal
+     * @return false otherwise
+     */
+    bool equals(int64_t num) const
+    {
+        uint8_t digits[20];
+        size_t count = int64_digits(num, digits);
+        return is_negative == (num < 0) && vec.size() == count && std::equal(vec.begin(), vec.end(), digits);
+    }
+
+    /**
+     * @brief A counter-based 64-bit random engine for bulk generation.
+     *
+     * The n-th output is a fixed mix of the seed and n (the SplitMix64 finalizer),
+     * so outputs don't depend on each other and generate() fills a whole block in
+     * a loop without a carried dependency. It satisfies UniformRandomBitGenerator
+     * and can be used with any <random> distribution. It is not cryptographically
+     * secure.
+     *
+     */
+    class counter_engine
+    {
+    public:
+        using result_type = uint64_t;
+
+        /**
+         * @brief Construct a new counter_engine object from a seed.
+         *
+         * @param seed The seed; equal seeds give equal sequences
+         */
+        explicit counter_engine(uint64_t seed = 0) : key(mix(seed)) {}
+
+        /**
+         * @brief Returns the smallest value the engine produces.
+         *
+         * @return result_type Always 0
+         */
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Returns the largest value the engine produces.
+         *
+         * @return result_type Always 2^64 - 1
+         */
+        static constexpr result_type max()
+        {
+            return UINT64_MAX;
+        }
+
+        /**
+         * @brief Returns the next value of the sequence.
+         *
+         * @return result_type A uniformly distributed 64-bit value
+         */
+        result_type operator()()
+        {
+            return mix(key + gamma * ++counter);
+        }
+
+        /**
+         * @brief Writes the next n values of the sequence.
+         *
+         * Gives the same values as n calls of operator().
+         *
+         * @param out The destination of n values
+         * @param n The number of values
+         */
+        void generate(result_type *out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = mix(key + gamma * (counter + 1 + i));
+            counter += n;
+        }
+
+        /**
+         * @brief Skips the next n values of the sequence in constant time.
+         *
+         * @param n The number of values to skip
+         */
+        void discard(uint64_t n)
+        {
+            counter += n;
+        }
+
+    private:
+        /**
+         * @brief The increment between the inputs of successive outputs.
+         *
+         */
+        static constexpr uint64_t gamma = 0x9e3779b97f4a7c15ULL;
+
+        /**
+         * @brief The seed-dependent offset of the inputs.
+         *
+         */
+        uint64_t key;
+
+        /**
+         * @brief The number of values produced so far.
+         *
+         */
+        uint64_t counter = 0;
+
+        /**
+         * @brief Scrambles a 64-bit value with the SplitMix64 finalizer.
+         *
+         * @param z The value to scramble
+         * @return uint64_t The scrambled value
+         */
+        static constexpr uint64_t mix(uint64_t z)
+        {
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+    };
+
+    /**
+     * @brief Generates a uniformly distributed bigint in [0, 10^digits).
+     *
+     * The digits are written directly from 64-bit draws of the engine, 18 digits
+     * per accepted draw, without going through a string.
+     *
+     * @tparam URBG A UniformRandomBitGenerator, e.g. std::mt19937_64 or counter_engine
+     * @param digits The number of random digits
+     * @param gen The engine to draw from
+     * @return bigint A new one with a random value below 10^digits
+     */
+    template <class URBG>
+    static bigint random_digits(size_t digits, URBG &gen)
+    {
+        if (digits == 0)
+            return bigint(0);
+        std::vector<uint8_t> result(digits);
+        fill_digits(result.data(), digits, gen);
+        return bigint(false, std::move(result));
+    }
+
+    /**
+     * @brief Generates a uniformly distributed bigint in [0, 2^bits).
+     *
+     * The value is assembled from 64-bit draws, combined pairwise with powers of
+     * 2^64 so that the conversion to decimal digits uses the fast multiplication.
+     *
+     * @tparam URBG A UniformRandomBitGenerator
+     * @param bits The number of random bits
+     * @param gen The engine to draw from
+     * @return bigint A new one with a random value below 2^bits
+     */
+    template <class URBG>
+    static bigint random_bits(size_t bits, URBG &gen)
+    {
+        if (bits == 0)
+            return bigint(0);
+        std::vector<uint64_t> words((bits + 63) / 64);
+        draw_words(words.data(), words.size(), gen);
+        if (bits % 64 != 0)
+            words.back() &= (uint64_t(1) << (bits % 64)) - 1;
+
+        // powers[k] is 2^(64 * 2^k)
+        std::vector<std::vector<uint8_t>> powers{{6, 1, 6, 1, 5, 5, 9, 0, 7, 3, 7, 0, 4, 4, 7, 6, 4, 4, 8, 1}};
+        while ((size_t(1) << powers.size()) < words.size())
+        {
+            std::vector<uint8_t> square = multiply_vec(powers.back(), powers.back());
+            while (square.size() > 1 && square.back() == 0)
+                square.pop_back();
+            powers.push_back(std::move(square));
+        }
+        return bigint(false, words_to_vec(words.data(), words.size(), powers));
+    }
+
+    /**
+     * @brief Generates a uniformly distributed bigint in [0, bound).
+     *
+     * Rejection sampling on the digits: the leading digit is drawn below the
+     * leading digit of the bound plus one and the others freely, from the most
+     * significant down, and the draw starts over as soon as its prefix exceeds the
+     * bound. Fewer than two attempts are needed on average, and once the prefix
+     * is below the bound the remaining digits are filled in bulk.
+     *
+     * @tparam URBG A UniformRandomBitGenerator
+     * @param bound The exclusive upper bound, positive
+     * @param gen The engine to draw from
+     * @return bigint A new one with a random value below the bound
+     */
+    template <class URBG>
+    static bigint random_below(const bigint &bound, URBG &gen)
+    {
+        if (bound.is_negative || (bound.vec.size() == 1 && bound.vec[0] == 0))
+            throw std::invalid_argument("Bound must be positive");
+
+        const std::vector<uint8_t> &b = bound.vec;
+        std::vector<uint8_t> result(b.size());
+        while (true)
+        {
+            for (size_t i = b.size(); i-- > 0;)
+            {
+                result[i] = static_cast<uint8_t>(draw_below(i + 1 == b.size() ? b[i] + 1u : 10u, gen));
+                if (result[i] < b[i])
+                {
+                    fill_digits(result.data(), i, gen);
+                    return bigint(false, std::move(result));
+                }
+                if (result[i] > b[i])
+                    break;
+            }
+            // The prefix exceeded the bound, or the draw is the bound itself
+        }
+    }
+
+    /**
+     * @brief Sets every bigint of a range to a uniformly distributed value in [0, 10^digits).
+     *
+     * The digits are written straight into the storage of each element, which is
+     * reused when it is large enough. With counter_engine the 64-bit draws are
+     * produced a block at a time.
+     *
+     * @tparam ForwardIt A forward iterator over bigint
+     * @tparam URBG A UniformRandomBitGenerator
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @param digits The number of random digits of each value
+     * @param gen The engine to draw from
+     */
+    template <class ForwardIt, class URBG>
+    static void fill_random(ForwardIt first, ForwardIt last, size_t digits, URBG &gen)
+    {
+        for (; first != last; ++first)
+        {
+            bigint &value = *first;
+            value.is_negative = false;
+            value.vec.resize(std::max<size_t>(digits, 1));
+            value.vec[0] = 0;
+            fill_digits(value.vec.data(), digits, gen);
+            value.trim();
+            value.apply_shrink_policy();
+        }
+    }
+
+    /**
+     * @brief Policies deciding when the digit vector gives back unused capacity.
+     *
+     * - `never`: keep whatever capacity the vector ended up with.
+     * - `slack`: shrink when the unused capacity exceeds a quarter of the digits.
+     * - `always`: shrink every newly produced value to its exact size.
+     *
+     */
+    enum class shrink_policy
+    {
+        never,
+        slack,
+        always
+    };
+
+    /**
+     * @brief Sets the shrink policy applied to every newly produced bigint.
+     *
+     * The policy is global and meant to be chosen once at start-up, e.g. `always`
+     * for programs that hold many values in long-lived caches.
+     *
+     * @param policy The new shrink policy
+     */
+    static void set_shrink_policy(shrink_policy policy)
+    {
+        current_shrink_policy = policy;
+    }
+
+    /**
+     * @brief Returns the shrink policy applied to every newly produced bigint.
+     *
+     * @return shrink_policy The current shrink policy
+     */
+    static shrink_policy get_shrink_policy()
+    {
+        return current_shrink_policy;
+    }
+
+    /**
+     * @brief Sets the operand size from which multiplication uses Karatsuba.
+     *
+     * Products whose shorter operand has fewer digits use the schoolbook method.
+     * `bigint_tune` measures the crossover on the current machine.
+     *
+     * @param digits The new threshold in decimal digits (at least 2)
+     */
+    static void set_karatsuba_threshold(size_t digits)
+    {
+        karatsuba_threshold = std::max<size_t>(digits, 2);
+    }
+
+    /**
+     * @brief Returns the operand size from which multiplication uses Karatsuba.
+     *
+     * @return size_t The threshold in decimal digits
+     */
+    static size_t get_karatsuba_threshold()
+    {
+        return karatsuba_threshold;
+    }
+
+    /**
+     * @brief Returns the number of bytes used by the bigint object.
+     *
+     * This is the size of the object itself plus the capacity of the digit vector,
+     * including unused capacity. Bookkeeping of the heap allocator isn't included.
+     *
+     * @return size_t The number of bytes used
+     */
+    size_t memory_usage() const
+    {
+        return sizeof(bigint) + vec.capacity() * sizeof(uint8_t);
+    }
+
+    /**
+     * @brief Releases the unused capacity of the digit vector.
+     *
+     */
+    void shrink_to_fit()
+    {
+        vec.shrink_to_fit();
     }
 
     /**
@@ -533,6 +1133,7 @@ public:
         }
 
         // If str contains invalid character
+        vec.reserve(str.size() - index);
         for (size_t i = str.size(); i > index; --i)
         {
             if (!std::isdigit(str[i - 1]))
@@ -548,6 +1149,7 @@ public:
 
         // Trim leading zero and avoid Negative zero
         trim();
+        apply_shrink_policy();
     }
 
     /**
@@ -649,16 +1251,46 @@ private:
      */
     std::vector<uint8_t> vec = std::vector<uint8_t>();
 
+    /**
+     * @brief The shrink policy applied to every newly produced bigint.
+     *
+     */
+    inline static shrink_policy current_shrink_policy = shrink_policy::never;
+
+    /**
+     * @brief The operand size from which multiplication uses Karatsuba.
+     *
+     */
+    inline static size_t karatsuba_threshold = 48;
+
     /**
      * @brief Construct a new bigint object from a sign indicator and a vector of digits.
      *
      * This constructor initializes the bigint object directly with the provided sign
-     * and digit vector.
+     * and digit vector. The vector is taken by value so that the temporary results of
+     * the arithmetic helpers are moved in rather than copied.
      *
      * @param negative Indicates if the number is negative (true for negative).
      * @param vector The vector containing the digits of the number in reverse order.
      */
-    bigint(bool negative, const std::vector<uint8_t> &vector) : is_negative(negative), vec(vector) { trim(); }
+    bigint(bool negative, std::vector<uint8_t> vector) : is_negative(negative), vec(std::move(vector))
+    {
+        trim();
+        apply_shrink_policy();
+    }
+
+    /**
+     * @brief Releases unused capacity according to the current shrink policy.
+     *
+     */
+    void apply_shrink_policy()
+    {
+        if (current_shrink_policy == shrink_policy::never)
+            return;
+        size_t slack = vec.capacity() - vec.size();
+        if (current_shrink_policy == shrink_policy::always ? slack > 0 : slack > vec.size() / 4)
+            vec.shrink_to_fit();
+    }
 
     /**
      * @brief Removes leading zeros from the bigint representation.
@@ -692,6 +1324,9 @@ private:
         size_t max_size = std::max(a.size(), b.size());
         int carry = 0;
 
+        // At most one extra digit for the final carry
+        result.reserve(max_size + 1);
+
         for (size_t i = 0; i < max_size || carry; ++i)
         {
             int sum = carry;
@@ -720,6 +1355,8 @@ private:
         std::vector<uint8_t> result = std::vector<uint8_t>();
         int borrow = 0;
 
+        result.reserve(a.size());
+
         for (size_t i = 0; i < a.size(); ++i)
         {
             int diff = a[i] - borrow;
@@ -743,6 +1380,506 @@ private:
         return result;
     }
 
+    /**
+     * @brief Multiplies two vectors representing reversed-digit numbers.
+     *
+     * Operands with at least karatsuba_threshold digits are split in halves and
+     * multiplied with three half-size products instead of four. An operand that is
+     * less than half the length of the other is multiplied piece by piece.
+     *
+     * @param a The first number as a vector of digits in reverse order.
+     * @param b The second number as a vector of digits in reverse order.
+     * @return std::vector<uint8_t> The product, possibly with leading zeros.
+     */
+    static std::vector<uint8_t> multiply_vec(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+    {
+        if (a.size() < b.size())
+            return multiply_vec(b, a);
+        if (b.size() < karatsuba_threshold)
+            return schoolbook_vec(a, b);
+
+        size_t half = a.size() / 2;
+        std::vector<uint8_t> a0(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(half));
+        std::vector<uint8_t> a1(a.begin() + static_cast<std::ptrdiff_t>(half), a.end());
+        std::vector<uint8_t> result(a.size() + b.size(), 0);
+
+        if (b.size() <= half)
+        {
+            add_shifted(result, multiply_vec(a0, b), 0);
+            add_shifted(result, multiply_vec(a1, b), half);
+            return result;
+        }
+
+        // (a1 x + a0)(b1 x + b0) = z2 x^2 + z1 x + z0, with z1 = (a0 + a1)(b0 + b1) - z0 - z2
+        std::vector<uint8_t> b0(b.begin(), b.begin() + static_cast<std::ptrdiff_t>(half));
+        std::vector<uint8_t> b1(b.begin() + static_cast<std::ptrdiff_t>(half), b.end());
+        std::vector<uint8_t> z0 = multiply_vec(a0, b0);
+        std::vector<uint8_t> z2 = multiply_vec(a1, b1);
+        std::vector<uint8_t> z1 = multiply_vec(add_vec(a0, a1), add_vec(b0, b1));
+        subtract_in_place(z1, z0);
+        subtract_in_place(z1, z2);
+
+        add_shifted(result, z0, 0);
+        add_shifted(result, z1, half);
+        add_shifted(result, z2, 2 * half);
+        return result;
+    }
+
+    /**
+     * @brief Multiplies two vectors digit by digit.
+     *
+     * @param a The first number as a vector of digits in reverse order.
+     * @param b The second number as a vector of digits in reverse order.
+     * @return std::vector<uint8_t> The product, possibly with leading zeros.
+     */
+    static std::vector<uint8_t> schoolbook_vec(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+    {
+        // Initialize a vector to hold the product
+        // It's properly sized for maximum possible digits
+        std::vector<uint8_t> product(a.size() + b.size(), 0);
+
+        // Perform digit-by-digit multiplication
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            int carry = 0;
+            for (size_t j = 0; j < b.size() || carry; ++j)
+            {
+                int64_t current = product[i + j] + a[i] * (j < b.size() ? b[j] : 0) + carry;
+                product[i + j] = static_cast<uint8_t>(current % 10);
+                carry = static_cast<uint8_t>(current / 10);
+            }
+        }
+        return product;
+    }
+
+    /**
+     * @brief Adds a vector into another at a digit offset.
+     *
+     * Digits and carries past the end of `result` are dropped; the callers size
+     * `result` so that they are zero.
+     *
+     * @param result The vector to add into, in reverse order.
+     * @param b The vector to add, in reverse order.
+     * @param offset The number of digits to shift `b` by.
+     */
+    static void add_shifted(std::vector<uint8_t> &result, const std::vector<uint8_t> &b, size_t offset)
+    {
+        int carry = 0;
+        for (size_t i = 0; (i < b.size() || carry) && offset + i < result.size(); ++i)
+        {
+            int sum = result[offset + i] + carry + (i < b.size() ? b[i] : 0);
+            result[offset + i] = static_cast<uint8_t>(sum % 10);
+            carry = sum / 10;
+        }
+    }
+
+    /**
+     * @brief Adds a value with a given sign to the current one, in its own digit vector.
+     *
+     * Only the digits of `rhs` and the carry chain past them are touched, and
+     * the vector only grows when the sum is longer, so a running total doesn't
+     * allocate on every addition. When the result takes the sign of `rhs`,
+     * the difference is computed into a new vector.
+     *
+     * @param rhs The value whose digits are added
+     * @param negative The sign to add them with
+     */
+    void add_in_place(const bigint &rhs, bool negative)
+    {
+        if (&rhs == this)
+        {
+            bigint copy = rhs;
+            add_in_place(copy, negative);
+            return;
+        }
+
+        if (is_negative == negative)
+        {
+            if (vec.size() < rhs.vec.size())
+                vec.resize(rhs.vec.size(), 0);
+
+            // Grow only for a final carry, so the shrink policy sees no slack from it
+            uint8_t carry = 0;
+            size_t i = 0;
+            for (; i < rhs.vec.size(); ++i)
+            {
+                uint8_t sum = static_cast<uint8_t>(vec[i] + rhs.vec[i] + carry);
+                carry = sum >= 10;
+                vec[i] = carry ? static_cast<uint8_t>(sum - 10) : sum;
+            }
+            for (; carry && i < vec.size(); ++i)
+            {
+                carry = vec[i] == 9;
+                vec[i] = carry ? 0 : static_cast<uint8_t>(vec[i] + 1);
+            }
+            if (carry)
+                vec.push_back(1);
+        }
+        else if (abs_compare(vec, rhs.vec) >= 0)
+            subtract_in_place(vec, rhs.vec);
+        else
+        {
+            vec = subtract_vec(rhs.vec, vec);
+            is_negative = negative;
+        }
+        trim();
+        apply_shrink_policy();
+    }
+
+    /**
+     * @brief Subtracts a vector from another in place.
+     *
+     * @param a The minuend, not smaller than `b`, in reverse order.
+     * @param b The subtrahend, in reverse order.
+     */
+    static void subtract_in_place(std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+    {
+        int borrow = 0;
+        for (size_t i = 0; i < a.size() && (i < b.size() || borrow); ++i)
+        {
+            int diff = a[i] - borrow - (i < b.size() ? b[i] : 0);
+            borrow = diff < 0;
+            a[i] = static_cast<uint8_t>(diff < 0 ? diff + 10 : diff);
+        }
+    }
+
+    /**
+     * @brief Writes the digits of the absolute value of a signed 64-bit integer.
+     *
+     * @param num The signed 64-bit integer, INT64_MIN included
+     * @param digits The destination, in reverse order
+     * @return size_t The number of digits (zero has one digit)
+     */
+    static size_t int64_digits(int64_t num, uint8_t (&digits)[20])
+    {
+        uint64_t magnitude = num < 0 ? uint64_t(0) - static_cast<uint64_t>(num) : static_cast<uint64_t>(num);
+        size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<uint8_t>(magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        return count;
+    }
+
+    /**
+     * @brief Multiplies two 64-bit values and folds the 128-bit product to 64 bits.
+     *
+     * @param a The first value
+     * @param b The second value
+     * @return uint64_t The low half of the product xor its high half
+     */
+    static uint64_t hash_mix(uint64_t a, uint64_t b)
+    {
+        uint64_t high;
+        uint64_t low = multiply_wide(a, b, high);
+        return low ^ high;
+    }
+
+    /**
+     * @brief Multiplies two 64-bit values into a 128-bit product.
+     *
+     * Uses unsigned __int128 where the compiler has it, _umul128 on MSVC for
+     * x64, and four 32-bit products otherwise.
+     *
+     * @param a The first value
+     * @param b The second value
+     * @param high Receives the high half of the product
+     * @return uint64_t The low half of the product
+     */
+    static uint64_t multiply_wide(uint64_t a, uint64_t b, uint64_t &high)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        high = static_cast<uint64_t>(product >> 64);
+        return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return _umul128(a, b, &high);
+#else
+        uint64_t a_low = a & 0xFFFFFFFF, a_high = a >> 32, b_low = b & 0xFFFFFFFF, b_high = b >> 32;
+        uint64_t low_low = a_low * b_low, high_low = a_high * b_low;
+        uint64_t low_high = a_low * b_high, high_high = a_high * b_high;
+        uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+        high = high_high + (high_low >> 32) + (middle >> 32);
+        return (middle << 32) | (low_low & 0xFFFFFFFF);
+#endif
+    }
+
+    /**
+     * @brief Divides a 128-bit value by a 64-bit value whose quotient fits in 64 bits.
+     *
+     * Uses unsigned __int128 where the compiler has it, _udiv128 on MSVC 2019 for
+     * x64, and a two-step long division in 32-bit halves otherwise.
+     *
+     * @param high The high half of the dividend, less than the divisor
+     * @param low The low half of the dividend
+     * @param divisor The divisor, not zero
+     * @param remainder Receives the remainder
+     * @return uint64_t The quotient
+     */
+    static uint64_t divide_wide(uint64_t high, uint64_t low, uint64_t divisor, uint64_t &remainder)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 dividend = (static_cast<unsigned __int128>(high) << 64) | low;
+        remainder = static_cast<uint64_t>(dividend % divisor);
+        return static_cast<uint64_t>(dividend / divisor);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+        return _udiv128(high, low, divisor, &remainder);
+#else
+        // Normalize so the divisor has its top bit set, then find the quotient one
+        // 32-bit digit at a time from a two-digit estimate, as in Knuth's algorithm D
+        constexpr uint64_t half = uint64_t(1) << 32;
+        int shift = 0;
+        while ((divisor << shift >> 63) == 0)
+            ++shift;
+        divisor <<= shift;
+        uint64_t divisor_high = divisor >> 32, divisor_low = divisor & 0xFFFFFFFF;
+        uint64_t top = shift == 0 ? high : (high << shift) | (low >> (64 - shift));
+        low <<= shift;
+        uint64_t low_high = low >> 32, low_low = low & 0xFFFFFFFF;
+
+        uint64_t q1 = top / divisor_high, estimate = top - q1 * divisor_high;
+        while (q1 >= half || q1 * divisor_low > estimate * half + low_high)
+        {
+            --q1;
+            estimate += divisor_high;
+            if (estimate >= half)
+                break;
+        }
+        uint64_t middle = top * half + low_high - q1 * divisor;
+
+        uint64_t q0 = middle / divisor_high;
+        estimate = middle - q0 * divisor_high;
+        while (q0 >= half || q0 * divisor_low > estimate * half + low_low)
+        {
+            --q0;
+            estimate += divisor_high;
+            if (estimate >= half)
+                break;
+        }
+        remainder = (middle * half + low_low - q0 * divisor) >> shift;
+        return q1 * half + q0;
+#endif
+    }
+
+    /**
+     * @brief Loads eight bytes as a 64-bit value, without alignment requirements.
+     *
+     * @param p The first byte
+     * @return uint64_t The value
+     */
+    static uint64_t hash_load(const uint8_t *p)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief Hashes a digit array and a sign.
+     *
+     * 64-byte blocks go through four independent lanes, so the multiplications
+     * of a block overlap; the remaining 16-byte pieces and the zero-padded tail
+     * go through a single lane.
+     *
+     * @param p The digits in reverse order
+     * @param n The number of digits
+     * @param negative The sign
+     * @return uint64_t The hash
+     */
+    static uint64_t hash_digits(const uint8_t *p, size_t n, bool negative)
+    {
+        constexpr uint64_t k0 = 0xa0761d6478bd642fULL, k1 = 0xe7037ed1a0b428dbULL, k2 = 0x8ebc6af09c88c6e3ULL, k3 = 0x589965cc75374cc3ULL;
+        uint64_t seed = k0 ^ hash_mix(n ^ k1, negative ? k2 : k3);
+        size_t i = 0;
+        if (n >= 64)
+        {
+            uint64_t lanes[4] = {seed, seed ^ k1, seed ^ k2, seed ^ k3};
+            for (; i + 64 <= n; i += 64)
+                for (size_t l = 0; l < 4; ++l)
+                    lanes[l] = hash_mix(hash_load(p + i + 16 * l) ^ k1, hash_load(p + i + 16 * l + 8) ^ lanes[l]);
+            seed = hash_mix(lanes[0] ^ lanes[1], lanes[2] ^ lanes[3] ^ k0);
+        }
+        for (; i + 16 <= n; i += 16)
+            seed = hash_mix(hash_load(p + i) ^ k1, hash_load(p + i + 8) ^ seed);
+        if (i < n)
+        {
+            uint8_t tail[16] = {};
+            std::memcpy(tail, p + i, n - i);
+            seed = hash_mix(hash_load(tail) ^ k1, hash_load(tail + 8) ^ seed);
+        }
+        return hash_mix(seed ^ k2, n ^ k3);
+    }
+
+    /**
+     * @brief Draws a uniformly distributed 64-bit value from an engine.
+     *
+     * @tparam URBG A UniformRandomBitGenerator
+     * @param gen The engine to draw from
+     * @return uint64_t The value
+     */
+    template <class URBG>
+    static uint64_t draw_word(URBG &gen)
+    {
+        if constexpr (URBG::min() == 0 && URBG::max() == UINT64_MAX)
+            return static_cast<uint64_t>(gen());
+        else
+            return std::uniform_int_distribution<uint64_t>()(gen);
+    }
+
+    /**
+     * @brief Draws n uniformly distributed 64-bit values from an engine.
+     *
+     * @tparam URBG A UniformRandomBitGenerator
+     * @param out The destination of n values
+     * @param n The number of values
+     * @param gen The engine to draw from
+     */
+    template <class URBG>
+    static void draw_words(uint64_t *out, size_t n, URBG &gen)
+    {
+        if constexpr (std::is_same_v<URBG, counter_engine>)
+            gen.generate(out, n);
+        else
+            for (size_t i = 0; i < n; ++i)
+                out[i] = draw_word(gen);
+    }
+
+    /**
+     * @brief Draws a uniformly distributed value in [0, n) by rejection.
+     *
+     * @tparam URBG A UniformRandomBitGenerator
+     * @param n The exclusive upper bound, positive
+     * @param gen The engine to draw from
+     * @return uint64_t The value
+     */
+    template <class URBG>
+    static uint64_t draw_below(uint64_t n, URBG &gen)
+    {
+        uint64_t limit = UINT64_MAX - UINT64_MAX % n;
+        uint64_t w;
+        do
+            w = draw_word(gen);
+        while (w >= limit);
+        return w % n;
+    }
+
+    /**
+     * @brief Writes n uniformly distributed decimal digits.
+     *
+     * Each 64-bit draw below 18 * 10^18 gives 18 digits, split into two 9-digit
+     * halves so that the digits are peeled with 32-bit arithmetic.
+     *
+     * @tparam URBG A UniformRandomBitGenerator
+     * @param out The destination of n digits
+     * @param n The number of digits
+     * @param gen The engine to draw from
+     */
+    template <class URBG>
+    static void fill_digits(uint8_t *out, size_t n, URBG &gen)
+    {
+        constexpr uint64_t chunk = 1000000000000000000ULL;
+        constexpr uint64_t limit = 18 * chunk;
+        uint64_t words[32];
+        while (n > 0)
+        {
+            size_t want = std::min<size_t>(32, (n + 17) / 18);
+            draw_words(words, want, gen);
+            for (size_t k = 0; k < want && n > 0; ++k)
+            {
+                if (words[k] >= limit)
+                    continue;
+                uint64_t w = words[k] % chunk;
+                uint32_t halves[2] = {static_cast<uint32_t>(w % 1000000000), static_cast<uint32_t>(w / 1000000000)};
+                size_t take = std::min<size_t>(18, n);
+                for (size_t d = 0; d < take; ++d)
+                {
+                    uint32_t &half = halves[d / 9];
+                    out[d] = static_cast<uint8_t>(half % 10);
+                    half /= 10;
+                }
+                out += take;
+                n -= take;
+            }
+        }
+    }
+
+    /**
+     * @brief Converts the absolute value to 64-bit words.
+     *
+     * The digits are read 18 at a time from the most significant, and each group
+     * is multiplied in with one pass over the words converted so far.
+     *
+     * @return std::vector<uint64_t> The words, least significant first, without leading zero words
+     */
+    std::vector<uint64_t> to_words() const
+    {
+        constexpr uint64_t group_base = 1000000000000000000ULL;
+        std::vector<uint64_t> words;
+        words.reserve(vec.size() / 19 + 2);
+        size_t first = vec.size() % 18 == 0 ? 18 : vec.size() % 18;
+        for (size_t end = vec.size(), take = first; end > 0; end -= take, take = 18)
+        {
+            uint64_t carry = 0;
+            for (size_t i = end; i > end - take; --i)
+                carry = carry * 10 + vec[i - 1];
+            for (uint64_t &word : words)
+            {
+                uint64_t high;
+                uint64_t low = multiply_wide(word, group_base, high);
+                word = low + carry;
+                carry = high + (word < low);
+            }
+            if (carry != 0)
+                words.push_back(carry);
+        }
+        return words;
+    }
+
+    /**
+     * @brief Converts a 64-bit value to a vector of digits in reverse order.
+     *
+     * @param w The value
+     * @return std::vector<uint8_t> The digits, without leading zeros
+     */
+    static std::vector<uint8_t> word_to_vec(uint64_t w)
+    {
+        std::vector<uint8_t> result;
+        do
+        {
+            result.push_back(static_cast<uint8_t>(w % 10));
+            w /= 10;
+        } while (w != 0);
+        return result;
+    }
+
+    /**
+     * @brief Converts little-endian 64-bit words to a vector of digits in reverse order.
+     *
+     * The words are split so that the low part has a power of two count, and the
+     * high part is multiplied by the matching power of 2^64.
+     *
+     * @param words The words, least significant first
+     * @param count The number of words, positive
+     * @param powers powers[k] holds 2^(64 * 2^k), for every 2^k below count
+     * @return std::vector<uint8_t> The digits, without leading zeros
+     */
+    static std::vector<uint8_t> words_to_vec(const uint64_t *words, size_t count, const std::vector<std::vector<uint8_t>> &powers)
+    {
+        if (count == 1)
+            return word_to_vec(words[0]);
+        size_t level = 0;
+        while ((size_t(2) << level) < count)
+            ++level;
+        size_t half = size_t(1) << level;
+
+        std::vector<uint8_t> result = multiply_vec(words_to_vec(words + half, count - half, powers), powers[level]);
+        add_shifted(result, words_to_vec(words, half, powers), 0);
+        while (result.size() > 1 && result.back() == 0)
+            result.pop_back();
+        return result;
+    }
+
     /**
      * @brief Compares the absolute values of two numbers represented as digit vectors.
      *
@@ -765,35 +1902,22 @@ private:
         }
         return 0;
     }
+};
 
+namespace std
+{
     /**
-     * @brief Divides the bigint by a given base and calculates the remainder.
+     * @brief Hashes bigint values with bigint::hash(), so they can key unordered containers.
      *
-     * This function performs division of the current bigint object by the specified base
-     * and returns the resulting quotient as a new bigint. The remainder of the division
-     * is stored in the provided `remainder` parameter as a bigint. This method works
-     * by processing the bigint digit-by-digit, handling carry values to simulate manual division.
-     *
-     * @param base The base to divide the bigint by (must be greater than 1).
-     * @param remainder A reference to a bigint object where the remainder will be stored.
-     * @return bigint The quotient of the division as a bigint.
      */
-    bigint divide_by_base(uint64_t base, bigint &remainder) const
+    template <>
+    struct hash<bigint>
     {
-        bigint result;
-        result.vec.resize(vec.size());
-
-        uint64_t carry = 0;
-
-        for (size_t i = vec.size(); i > 0; --i)
+        size_t operator()(const bigint &value) const
         {
-            carry = carry * 10 + vec[i - 1];
-            result.vec[i - 1] = static_cast<uint8_t>(carry / base);
-            carry %= base;
+            return value.hash();
         }
+    };
+}
 
-        remainder = bigint(static_cast<int>(carry));
-        result.trim();
-        return result;
-    }
-};
+#endif // BIGINT_HPP
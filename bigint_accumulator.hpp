@@ -0,0 +1,249 @@
+/**
+ * @file bigint_accumulator.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_accumulator
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_ACCUMULATOR_HPP
+#define BIGINT_ACCUMULATOR_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A running sum of bigint values with deferred carry propagation
+ *
+ * Every decimal position of the sum has a 32-bit signed slot, and adding a
+ * value adds each of its digits to the slot of its position, with no carry
+ * and no allocation once the slots are as long as the value. The slots are
+ * only normalized, each carry moved into the next position, when the value is
+ * read or when the number of additions since the last normalization reaches
+ * the budget that keeps every slot from overflowing.
+ *
+ * Accumulators summing parts of a sequence, e.g. one per thread, can be
+ * combined with merge().
+ *
+ */
+class bigint_accumulator
+{
+public:
+    /**
+     * @brief Adds a value to the sum.
+     *
+     * @param x The value to add
+     * @return bigint_accumulator& A reference to the current object after the operation
+     */
+    bigint_accumulator &operator+=(const bigint &x)
+    {
+        accumulate(x.vec, x.is_negative);
+        return *this;
+    }
+
+    /**
+     * @brief Subtracts a value from the sum.
+     *
+     * @param x The value to subtract
+     * @return bigint_accumulator& A reference to the current object after the operation
+     */
+    bigint_accumulator &operator-=(const bigint &x)
+    {
+        accumulate(x.vec, !x.is_negative);
+        return *this;
+    }
+
+    /**
+     * @brief Adds the sum of another accumulator to this one.
+     *
+     * @param other The accumulator to merge, left unchanged
+     * @return bigint_accumulator& A reference to the current object after the operation
+     */
+    bigint_accumulator &merge(const bigint_accumulator &other)
+    {
+        if (pending + other.pending >= budget)
+            normalize();
+        if (slots.size() < other.slots.size())
+            slots.resize(other.slots.size(), 0);
+        for (size_t i = 0; i < other.slots.size(); ++i)
+            slots[i] += other.slots[i];
+
+        // The other slots may hold a digit more than their additions account for
+        pending += other.pending + 1;
+        return *this;
+    }
+
+    /**
+     * @brief Returns the sum.
+     *
+     * The slots are normalized in a copy, so reading doesn't change the state.
+     *
+     * @return bigint The sum
+     */
+    bigint value() const
+    {
+        std::vector<int64_t> wide(slots.begin(), slots.end());
+        int64_t top = propagate(wide);
+        bool negative = top < 0;
+        if (negative)
+        {
+            // The sum is top * 10^n plus non-negative digits, so its magnitude
+            // is -top * 10^n minus the digits
+            for (int64_t &slot : wide)
+                slot = -slot;
+            top = -top + propagate(wide);
+        }
+
+        std::vector<uint8_t> digits(wide.begin(), wide.end());
+        for (; top > 0; top /= 10)
+            digits.push_back(static_cast<uint8_t>(top % 10));
+        if (digits.empty())
+            digits.push_back(0);
+        return bigint(negative, std::move(digits));
+    }
+
+    /**
+     * @brief Moves every carry into the next position, so each slot holds a digit.
+     *
+     * This happens by itself when the budget of additions is used up, and
+     * doesn't change the sum.
+     *
+     */
+    void normalize()
+    {
+        std::vector<int64_t> wide(slots.begin(), slots.end());
+        int64_t top = propagate(wide);
+        slots.assign(wide.begin(), wide.end());
+
+        // A negative sum keeps a negative top slot, the others hold digits
+        while (top >= 10 || top <= -10)
+        {
+            int64_t digit = top % 10;
+            top /= 10;
+            if (digit < 0)
+            {
+                digit += 10;
+                --top;
+            }
+            slots.push_back(static_cast<int32_t>(digit));
+        }
+        if (top != 0)
+            slots.push_back(static_cast<int32_t>(top));
+        pending = 0;
+    }
+
+    /**
+     * @brief Returns the number of additions since the last normalization.
+     *
+     * @return size_t The number of additions
+     */
+    size_t additions() const
+    {
+        return pending;
+    }
+
+    /**
+     * @brief Resets the sum to zero, keeping the slots' memory.
+     *
+     */
+    void clear()
+    {
+        slots.clear();
+        pending = 0;
+    }
+
+    /**
+     * @brief Construct a new bigint_accumulator object with a sum of 0.
+     *
+     */
+    bigint_accumulator() = default;
+
+    /**
+     * @brief Construct a new bigint_accumulator object with an initial sum.
+     *
+     * @param initial The initial sum
+     */
+    explicit bigint_accumulator(const bigint &initial)
+    {
+        *this += initial;
+    }
+
+private:
+    /**
+     * @brief The number of additions after which the slots must be normalized.
+     *
+     * A normalized slot is between -9 and 9 and each addition adds at most 9,
+     * so this many additions keep every slot within int32_t.
+     *
+     */
+    static constexpr size_t budget = (INT32_MAX - 9) / 9;
+
+    /**
+     * @brief The sum of the digits added at every position, least significant first.
+     *
+     */
+    std::vector<int32_t> slots;
+
+    /**
+     * @brief The number of additions since the last normalization.
+     *
+     */
+    size_t pending = 0;
+
+    /**
+     * @brief Adds or subtracts the digits of a value to their slots.
+     *
+     * @param digits The digits of the value, least significant first
+     * @param subtract Whether to subtract them
+     */
+    void accumulate(const std::vector<uint8_t> &digits, bool subtract)
+    {
+        if (pending + 1 >= budget)
+            normalize();
+        if (slots.size() < digits.size())
+            slots.resize(digits.size(), 0);
+
+        // Separate loops without a branch inside, so both widen and add a vector at a time
+        int32_t *out = slots.data();
+        const uint8_t *in = digits.data();
+        size_t n = digits.size();
+        if (subtract)
+            for (size_t i = 0; i < n; ++i)
+                out[i] -= in[i];
+        else
+            for (size_t i = 0; i < n; ++i)
+                out[i] += in[i];
+        ++pending;
+    }
+
+    /**
+     * @brief Propagates the carries of wide slots, leaving a digit in each.
+     *
+     * @param wide The slots, least significant first
+     * @return int64_t The carry out of the highest slot, negative for a negative sum
+     */
+    static int64_t propagate(std::vector<int64_t> &wide)
+    {
+        int64_t carry = 0;
+        for (int64_t &slot : wide)
+        {
+            int64_t t = slot + carry;
+            int64_t digit = t % 10;
+            carry = t / 10;
+            if (digit < 0)
+            {
+                digit += 10;
+                --carry;
+            }
+            slot = digit;
+        }
+        return carry;
+    }
+};
+
+#endif // BIGINT_ACCUMULATOR_HPP
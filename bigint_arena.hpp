@@ -0,0 +1,748 @@
+/**
+ * @file bigint_arena.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_arena
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_ARENA_HPP
+#define BIGINT_ARENA_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Relocatable bigint storage in a POSIX shared memory segment
+ *
+ * Values are stored once, in the digit layout of bigint, and referred to by
+ * their offset from the start of the segment rather than by pointer, so every
+ * process mapping the segment can use them wherever the mapping lands. One
+ * process creates the arena and stores tables of values; workers open it
+ * read-only and take views of the values, so N processes share one copy of
+ * the digits instead of each parsing and holding its own.
+ *
+ * Offsets can be published under a name in a small directory at the start
+ * of the segment, for other processes to find. Space is taken by an atomic
+ * bump of the used size and never freed, so several processes may store and
+ * publish concurrently; a published value is complete before its name is
+ * visible.
+ *
+ * Only available on POSIX systems. With glibc before 2.34, link with -lrt.
+ *
+ */
+class bigint_arena
+{
+    /**
+     * @brief The header of a stored value or table.
+     *
+     */
+    struct record
+    {
+        uint32_t kind;
+        uint32_t negative;
+        uint64_t length;
+    };
+
+public:
+    /**
+     * @brief The position of a stored value or table, in bytes from the start of the segment.
+     *
+     * No value is stored at offset 0, which lookups use for "not found".
+     *
+     */
+    using offset = uint64_t;
+
+    /**
+     * @brief A read-only view of a value stored in an arena
+     *
+     * A view reads the digits in the segment directly and is valid while the
+     * arena is mapped. Comparisons and output work on the shared digits;
+     * arithmetic copies the digits of the view into a temporary bigint and
+     * returns a bigint.
+     *
+     */
+    class view
+    {
+        /**
+         * @brief I/O operator for insertion overloading
+         *
+         * @param out an instance of std::ostream
+         * @param v the view whose value will be output
+         * @return std::ostream& A reference to the same output stream that's passed as an argument
+         */
+        friend std::ostream &operator<<(std::ostream &out, const view &v)
+        {
+            char chunk[4096];
+            size_t used = 0;
+            if (v.negative)
+                chunk[used++] = '-';
+            for (size_t i = v.len; i > 0; --i)
+            {
+                if (used == sizeof(chunk))
+                {
+                    out.write(chunk, static_cast<std::streamsize>(used));
+                    used = 0;
+                }
+                chunk[used++] = static_cast<char>('0' + v.data[i - 1]);
+            }
+            return out.write(chunk, static_cast<std::streamsize>(used));
+        }
+
+    public:
+        /**
+         * @brief Returns the number of decimal digits of the absolute value.
+         *
+         * @return size_t The number of digits
+         */
+        size_t digits() const
+        {
+            return len;
+        }
+
+        /**
+         * @brief Returns one decimal digit of the absolute value.
+         *
+         * @param i The position, 0 for the least significant digit
+         * @return uint8_t The digit, 0 beyond the most significant one
+         */
+        uint8_t digit(size_t i) const
+        {
+            return i < len ? data[i] : 0;
+        }
+
+        /**
+         * @brief Returns the sign of the value.
+         *
+         * @return int -1 for a negative value, 0 for zero and 1 for a positive value
+         */
+        int sign() const
+        {
+            return negative ? -1 : (len == 1 && data[0] == 0 ? 0 : 1);
+        }
+
+        /**
+         * @brief Copies the value into a bigint.
+         *
+         * @return bigint The value
+         */
+        bigint to_bigint() const
+        {
+            return bigint(negative, std::vector<uint8_t>(data, data + len));
+        }
+
+        /**
+         * @brief Converts to a bigint, so a view can be passed where a bigint is expected.
+         *
+         * @return bigint A copy of the value
+         */
+        operator bigint() const
+        {
+            return to_bigint();
+        }
+
+        /**
+         * @brief Compares with a number whose digits are read through digit().
+         *
+         * @tparam Number view or bigint
+         * @param rhs The number to compare with
+         * @return int Negative, zero or positive as the view is less than, equal to or greater than rhs
+         */
+        template <typename Number>
+        int compare(const Number &rhs) const
+        {
+            int s = sign(), rhs_sign = rhs.sign();
+            if (s != rhs_sign)
+                return s < rhs_sign ? -1 : 1;
+            int magnitude = 0;
+            if (len != rhs.digits())
+                magnitude = len < rhs.digits() ? -1 : 1;
+            else
+                for (size_t i = len; i > 0 && magnitude == 0; --i)
+                    if (data[i - 1] != rhs.digit(i - 1))
+                        magnitude = data[i - 1] < rhs.digit(i - 1) ? -1 : 1;
+            return s < 0 ? -magnitude : magnitude;
+        }
+
+        /**
+         * @brief Compares with a view or a bigint, reading both sets of digits in place.
+         *
+         */
+        bool operator==(const view &rhs) const { return compare(rhs) == 0; }
+        bool operator!=(const view &rhs) const { return compare(rhs) != 0; }
+        bool operator<(const view &rhs) const { return compare(rhs) < 0; }
+        bool operator<=(const view &rhs) const { return compare(rhs) <= 0; }
+        bool operator>(const view &rhs) const { return compare(rhs) > 0; }
+        bool operator>=(const view &rhs) const { return compare(rhs) >= 0; }
+        bool operator==(const bigint &rhs) const { return compare(rhs) == 0; }
+        bool operator!=(const bigint &rhs) const { return compare(rhs) != 0; }
+        bool operator<(const bigint &rhs) const { return compare(rhs) < 0; }
+        bool operator<=(const bigint &rhs) const { return compare(rhs) <= 0; }
+        bool operator>(const bigint &rhs) const { return compare(rhs) > 0; }
+        bool operator>=(const bigint &rhs) const { return compare(rhs) >= 0; }
+
+        /**
+         * @brief Adds a number to the value
+         *
+         * @param rhs The number to add, a bigint or a view
+         * @return bigint The sum
+         */
+        bigint operator+(const bigint &rhs) const
+        {
+            return to_bigint() + rhs;
+        }
+
+        /**
+         * @brief Subtracts a number from the value
+         *
+         * @param rhs The number to subtract, a bigint or a view
+         * @return bigint The difference
+         */
+        bigint operator-(const bigint &rhs) const
+        {
+            return to_bigint() - rhs;
+        }
+
+        /**
+         * @brief Multiplies the value by a number
+         *
+         * @param rhs The factor, a bigint or a view
+         * @return bigint The product
+         */
+        bigint operator*(const bigint &rhs) const
+        {
+            return to_bigint() * rhs;
+        }
+
+        /**
+         * @brief Divides the value by a number, truncating toward zero
+         *
+         * @param rhs The divisor, a bigint or a view
+         * @return bigint The quotient
+         */
+        bigint operator/(const bigint &rhs) const
+        {
+            return to_bigint() / rhs;
+        }
+
+        /**
+         * @brief Computes the remainder of the value divided by a number
+         *
+         * @param rhs The divisor, a bigint or a view
+         * @return bigint The remainder
+         */
+        bigint operator%(const bigint &rhs) const
+        {
+            return to_bigint() % rhs;
+        }
+
+        /**
+         * @brief Unary operator - overloading
+         *
+         * @return bigint The negated value
+         */
+        bigint operator-() const
+        {
+            return -to_bigint();
+        }
+
+    private:
+        friend class bigint_arena;
+
+        /**
+         * @brief Construct a new view object of digits in a mapping.
+         *
+         * @param digits The digits, least significant first
+         * @param length The number of digits
+         * @param negative_value The sign
+         */
+        view(const uint8_t *digits, size_t length, bool negative_value) : data(digits), len(length), negative(negative_value) {}
+
+        const uint8_t *data;
+        size_t len;
+        bool negative;
+    };
+
+    /**
+     * @brief A read-only view of a table of values stored in an arena
+     *
+     */
+    class table
+    {
+    public:
+        /**
+         * @brief Returns the number of values in the table.
+         *
+         * @return size_t The number of values
+         */
+        size_t size() const
+        {
+            return count;
+        }
+
+        /**
+         * @brief Returns a view of a value of the table.
+         *
+         * @param i The index, less than size()
+         * @return view The view
+         */
+        view operator[](size_t i) const
+        {
+            offset at;
+            std::memcpy(&at, entries + i * sizeof(offset), sizeof(offset));
+            return arena->get(at);
+        }
+
+        /**
+         * @brief Returns a view of a value of the table, checking the index.
+         *
+         * @param i The index
+         * @return view The view
+         */
+        view at(size_t i) const
+        {
+            if (i >= count)
+                throw std::invalid_argument("Table index out of range");
+            return (*this)[i];
+        }
+
+    private:
+        friend class bigint_arena;
+
+        table(const bigint_arena *owner, const uint8_t *offsets, size_t size) : arena(owner), entries(offsets), count(size) {}
+
+        const bigint_arena *arena;
+        const uint8_t *entries;
+        size_t count;
+    };
+
+    /**
+     * @brief Creates a named shared memory segment and an empty arena in it.
+     *
+     * @param name The name of the segment, as for shm_open, e.g. "/powers"
+     * @param capacity The size of the segment in bytes
+     * @return bigint_arena The writable arena
+     */
+    static bigint_arena create(const std::string &name, size_t capacity)
+    {
+        capacity = std::max(capacity, sizeof(header));
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            throw std::runtime_error("Cannot create shared memory segment " + name);
+        if (ftruncate(fd, static_cast<off_t>(capacity)) != 0)
+        {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("Cannot size shared memory segment " + name);
+        }
+        bigint_arena arena;
+        try
+        {
+            arena.map(fd, capacity, true, name);
+        }
+        catch (...)
+        {
+            // The name exists since shm_open, so a failed mapping must not keep it
+            shm_unlink(name.c_str());
+            throw;
+        }
+        arena.initialize();
+        return arena;
+    }
+
+    /**
+     * @brief Opens an arena created by another process, or by this one.
+     *
+     * @param name The name of the segment
+     * @param writable Whether values can be stored and published through this mapping
+     * @return bigint_arena The arena
+     */
+    static bigint_arena open(const std::string &name, bool writable = false)
+    {
+        int fd = shm_open(name.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open shared memory segment " + name);
+        struct stat status;
+        if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(header))
+        {
+            close(fd);
+            throw std::runtime_error("Not a bigint arena: " + name);
+        }
+        bigint_arena arena;
+        arena.map(fd, static_cast<size_t>(status.st_size), writable, name);
+        if (arena.head()->magic != magic || arena.head()->capacity != arena.size)
+            throw std::runtime_error("Not a bigint arena: " + name);
+        return arena;
+    }
+
+    /**
+     * @brief Removes the name of a segment; mappings stay valid until they are unmapped.
+     *
+     * @param name The name of the segment
+     * @return true if the name existed
+     * @return false otherwise
+     */
+    static bool remove(const std::string &name)
+    {
+        return shm_unlink(name.c_str()) == 0;
+    }
+
+    /**
+     * @brief Stores a value.
+     *
+     * @param value The value
+     * @return offset The offset of the stored value
+     */
+    offset store(const bigint &value)
+    {
+        size_t length = value.digits();
+        offset at = allocate(sizeof(record) + length);
+        record r = {value_kind, value.sign() < 0 ? 1u : 0u, length};
+        std::memcpy(base + at, &r, sizeof(r));
+        uint8_t *digits = base + at + sizeof(record);
+        for (size_t i = 0; i < length; ++i)
+            digits[i] = value.digit(i);
+        return at;
+    }
+
+    /**
+     * @brief Stores a range of values and a table of their offsets.
+     *
+     * @tparam InputIt An input iterator over bigint
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @return offset The offset of the table
+     */
+    template <typename InputIt>
+    offset store_table(InputIt first, InputIt last)
+    {
+        std::vector<offset> offsets;
+        for (; first != last; ++first)
+            offsets.push_back(store(*first));
+        offset at = allocate(sizeof(record) + offsets.size() * sizeof(offset));
+        record r = {table_kind, 0, offsets.size()};
+        std::memcpy(base + at, &r, sizeof(r));
+        if (!offsets.empty())
+            std::memcpy(base + at + sizeof(record), offsets.data(), offsets.size() * sizeof(offset));
+        return at;
+    }
+
+    /**
+     * @brief Returns a view of a stored value.
+     *
+     * @param at The offset returned by store()
+     * @return view The view, valid while the arena is mapped
+     */
+    view get(offset at) const
+    {
+        record r = load(at, value_kind);
+        return view(base + at + sizeof(record), static_cast<size_t>(r.length), r.negative != 0);
+    }
+
+    /**
+     * @brief Returns a view of a stored table.
+     *
+     * @param at The offset returned by store_table()
+     * @return table The view, valid while the arena is mapped
+     */
+    table get_table(offset at) const
+    {
+        record r = load(at, table_kind);
+        return table(this, base + at + sizeof(record), static_cast<size_t>(r.length));
+    }
+
+    /**
+     * @brief Publishes an offset under a name, for other processes to find().
+     *
+     * @param name The name, at most 43 characters
+     * @param at The offset of a stored value or table
+     */
+    void publish(const std::string &name, offset at)
+    {
+        if (!writable)
+            throw std::runtime_error("Arena is read-only");
+        if (name.empty() || name.size() >= sizeof(entry::name))
+            throw std::invalid_argument("Invalid arena name");
+        for (entry &e : head()->directory)
+        {
+            uint32_t state = free_entry;
+            if (e.state.compare_exchange_strong(state, writing_entry, std::memory_order_acquire))
+            {
+                std::memcpy(e.name, name.c_str(), name.size() + 1);
+                e.at = at;
+                e.state.store(ready_entry, std::memory_order_release);
+                return;
+            }
+        }
+        throw std::runtime_error("Arena directory is full");
+    }
+
+    /**
+     * @brief Finds an offset published under a name.
+     *
+     * If the name was published more than once, the first offset is returned.
+     *
+     * @param name The name
+     * @return offset The offset, or 0 if the name isn't published
+     */
+    offset find(const std::string &name) const
+    {
+        for (const entry &e : head()->directory)
+            if (e.state.load(std::memory_order_acquire) == ready_entry && name == e.name)
+                return e.at;
+        return 0;
+    }
+
+    /**
+     * @brief Returns the number of bytes used, the header included.
+     *
+     * @return size_t The number of bytes
+     */
+    size_t used() const
+    {
+        return static_cast<size_t>(head()->used.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Returns the size of the segment in bytes.
+     *
+     * @return size_t The size
+     */
+    size_t capacity() const
+    {
+        return size;
+    }
+
+    /**
+     * @brief Construct a new arena object in an anonymous shared mapping.
+     *
+     * The arena is shared with the child processes forked afterwards.
+     *
+     * @param capacity The size of the mapping in bytes
+     */
+    explicit bigint_arena(size_t capacity)
+    {
+        size = std::max(capacity, sizeof(header));
+        void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("Cannot map an anonymous arena");
+        base = static_cast<uint8_t *>(mapping);
+        writable = true;
+        initialize();
+    }
+
+    bigint_arena(const bigint_arena &) = delete;
+    bigint_arena &operator=(const bigint_arena &) = delete;
+
+    /**
+     * @brief Construct a new arena object taking the mapping of another.
+     *
+     * @param other The arena to move from, left unmapped
+     */
+    bigint_arena(bigint_arena &&other) noexcept : base(other.base), size(other.size), writable(other.writable)
+    {
+        other.base = nullptr;
+        other.size = 0;
+    }
+
+    /**
+     * @brief Takes the mapping of another arena.
+     *
+     * @param other The arena to move from
+     * @return bigint_arena& A reference to the current object after the operation
+     */
+    bigint_arena &operator=(bigint_arena &&other) noexcept
+    {
+        std::swap(base, other.base);
+        std::swap(size, other.size);
+        std::swap(writable, other.writable);
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the arena object, unmapping the segment but leaving it and its name.
+     *
+     */
+    ~bigint_arena()
+    {
+        if (base)
+            munmap(base, size);
+    }
+
+private:
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "Atomics in shared memory must be lock-free");
+
+    static constexpr uint64_t magic = 0x6269676172656e61ULL;
+    static constexpr uint32_t value_kind = 1, table_kind = 2;
+    static constexpr uint32_t free_entry = 0, writing_entry = 1, ready_entry = 2;
+
+    /**
+     * @brief A published name and offset.
+     *
+     */
+    struct entry
+    {
+        std::atomic<uint32_t> state;
+        char name[44];
+        uint64_t at;
+    };
+
+    /**
+     * @brief The start of the segment: identification, bump allocator and directory.
+     *
+     */
+    struct header
+    {
+        uint64_t magic;
+        uint64_t capacity;
+        std::atomic<uint64_t> used;
+        entry directory[64];
+    };
+
+    /**
+     * @brief The start of the mapping.
+     *
+     */
+    uint8_t *base = nullptr;
+
+    /**
+     * @brief The size of the mapping in bytes.
+     *
+     */
+    size_t size = 0;
+
+    /**
+     * @brief Whether the mapping is writable.
+     *
+     */
+    bool writable = false;
+
+    /**
+     * @brief Construct a new unmapped arena object, to be mapped by create() or open().
+     *
+     */
+    bigint_arena() = default;
+
+    /**
+     * @brief Maps an open segment and closes its descriptor.
+     *
+     * @param fd The descriptor of the segment
+     * @param bytes The size of the segment
+     * @param write Whether to map it writable
+     * @param name The name of the segment, for errors
+     */
+    void map(int fd, size_t bytes, bool write, const std::string &name)
+    {
+        void *mapping = mmap(nullptr, bytes, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("Cannot map shared memory segment " + name);
+        base = static_cast<uint8_t *>(mapping);
+        size = bytes;
+        writable = write;
+    }
+
+    /**
+     * @brief Writes an empty header into a new, zero-filled mapping.
+     *
+     */
+    void initialize()
+    {
+        header *h = new (base) header();
+        h->capacity = size;
+        h->used.store(round_up(sizeof(header)), std::memory_order_relaxed);
+        h->magic = magic;
+    }
+
+    /**
+     * @brief Returns the header of the mapping.
+     *
+     * @return header* The header
+     */
+    header *head() const
+    {
+        return std::launder(reinterpret_cast<header *>(base));
+    }
+
+    /**
+     * @brief Rounds a size up to a multiple of 16, which keeps records aligned.
+     *
+     * @param bytes The size
+     * @return uint64_t The rounded size
+     */
+    static uint64_t round_up(uint64_t bytes)
+    {
+        return (bytes + 15) / 16 * 16;
+    }
+
+    /**
+     * @brief Takes space at the end of the used part of the segment.
+     *
+     * @param bytes The number of bytes
+     * @return offset The offset of the space
+     */
+    offset allocate(size_t bytes)
+    {
+        if (!writable)
+            throw std::runtime_error("Arena is read-only");
+        uint64_t need = round_up(bytes);
+        std::atomic<uint64_t> &used_bytes = head()->used;
+        uint64_t at = used_bytes.load(std::memory_order_relaxed);
+        do
+        {
+            if (need > size - at)
+                throw std::runtime_error("Arena is full");
+        } while (!used_bytes.compare_exchange_weak(at, at + need, std::memory_order_relaxed));
+        return at;
+    }
+
+    /**
+     * @brief Reads the header of a record, checking that the offset points to one of a kind.
+     *
+     * @param at The offset
+     * @param kind The expected kind
+     * @return record The header
+     */
+    record load(offset at, uint32_t kind) const
+    {
+        uint64_t end = head()->used.load(std::memory_order_acquire);
+        record r;
+        if (at < round_up(sizeof(header)) || at % 16 != 0 || at + sizeof(record) > end)
+            throw std::invalid_argument("Invalid arena offset");
+        std::memcpy(&r, base + at, sizeof(r));
+        uint64_t width = kind == table_kind ? sizeof(offset) : 1;
+        if (r.kind != kind || r.length > (end - at - sizeof(record)) / width || (kind == value_kind && r.length == 0))
+            throw std::invalid_argument("Invalid arena offset");
+        return r;
+    }
+};
+
+/**
+ * @brief Comparisons of a bigint with a view, reading the shared digits without a copy.
+ *
+ */
+inline bool operator==(const bigint &lhs, const bigint_arena::view &rhs) { return rhs.compare(lhs) == 0; }
+inline bool operator!=(const bigint &lhs, const bigint_arena::view &rhs) { return rhs.compare(lhs) != 0; }
+inline bool operator<(const bigint &lhs, const bigint_arena::view &rhs) { return rhs.compare(lhs) > 0; }
+inline bool operator<=(const bigint &lhs, const bigint_arena::view &rhs) { return rhs.compare(lhs) >= 0; }
+inline bool operator>(const bigint &lhs, const bigint_arena::view &rhs) { return rhs.compare(lhs) < 0; }
+inline bool operator>=(const bigint &lhs, const bigint_arena::view &rhs) { return rhs.compare(lhs) <= 0; }
+
+#endif // BIGINT_ARENA_HPP
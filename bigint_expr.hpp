@@ -0,0 +1,578 @@
+/**
+ * @file bigint_expr.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_expr
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_EXPR_HPP
+#define BIGINT_EXPR_HPP
+
+#include "bigint.hpp"
+#include "bigint_threads.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A lazily evaluated bigint formula
+ *
+ * An expression is a handle to a node of a graph: a constant, or an operation
+ * on the nodes of its operands. Building an expression computes nothing; its
+ * value is computed the first time it is asked for, together with the values
+ * of the subexpressions it needs, and kept in the node. Branches whose value
+ * is never asked for are never computed.
+ *
+ * The graph creates every node once: equal constants, and the same operation on
+ * the same operands (in either order for + and *), give the same node, so a
+ * subexpression written several times is computed once. Nodes live as long as
+ * their graph, and expressions must not outlive it.
+ *
+ */
+class bigint_expr
+{
+    /**
+     * @brief The operation of a node.
+     *
+     */
+    enum class op
+    {
+        constant,
+        add,
+        subtract,
+        multiply,
+        divide,
+        modulo,
+        negate
+    };
+
+    /**
+     * @brief A node of the graph.
+     *
+     * The operation and the operands never change. The value is written once,
+     * before done is set.
+     *
+     */
+    struct node
+    {
+        op operation;
+        node *lhs;
+        node *rhs;
+        bigint value;
+        std::atomic<bool> done{false};
+
+        /**
+         * @brief Scratch state of the evaluation that is running.
+         *
+         */
+        size_t mark = 0;
+        std::atomic<size_t> pending{0};
+        std::vector<node *> dependents;
+    };
+
+public:
+    /**
+     * @brief A graph owning the nodes of expressions
+     *
+     * Building and evaluating expressions of the same graph from several
+     * threads is safe; evaluations are run one at a time, each on
+     * bigint_threads::get_thread_count() threads.
+     *
+     */
+    class graph
+    {
+        friend class bigint_expr;
+
+    public:
+        /**
+         * @brief Returns the expression of a constant.
+         *
+         * @param value The value
+         * @return bigint_expr The expression, the same node for equal values
+         */
+        bigint_expr constant(const bigint &value)
+        {
+            std::lock_guard<std::mutex> guard(build_lock);
+            auto it = constants.find(value);
+            if (it != constants.end())
+                return bigint_expr(this, it->second);
+
+            node *n = create(op::constant, nullptr, nullptr);
+            n->value = value;
+            n->done.store(true, std::memory_order_release);
+            constants.emplace(value, n);
+            return bigint_expr(this, n);
+        }
+
+        /**
+         * @brief Computes the values of several expressions in one evaluation.
+         *
+         * With more than one thread, the subexpressions they share are
+         * scheduled once, and independent ones run in parallel.
+         *
+         * @param outputs The expressions, of this graph
+         */
+        void evaluate(const std::vector<bigint_expr> &outputs)
+        {
+            std::vector<node *> roots;
+            roots.reserve(outputs.size());
+            for (const bigint_expr &e : outputs)
+            {
+                if (e.owner != this)
+                    throw std::invalid_argument("Expression belongs to another graph.");
+                roots.push_back(e.n);
+            }
+            run(roots);
+        }
+
+        /**
+         * @brief Returns the number of nodes in the graph.
+         *
+         * @return size_t The number of distinct constants and operations
+         */
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> guard(build_lock);
+            return nodes.size();
+        }
+
+        /**
+         * @brief Returns the number of operations computed so far.
+         *
+         * @return size_t The number of operation nodes whose value was computed
+         */
+        size_t evaluations() const
+        {
+            return computed.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Construct a new, empty graph object.
+         *
+         */
+        graph() = default;
+
+        graph(const graph &) = delete;
+        graph &operator=(const graph &) = delete;
+
+    private:
+        /**
+         * @brief The operation and operands identifying an operation node.
+         *
+         */
+        struct key
+        {
+            op operation;
+            node *lhs;
+            node *rhs;
+
+            bool operator==(const key &other) const
+            {
+                return operation == other.operation && lhs == other.lhs && rhs == other.rhs;
+            }
+        };
+
+        /**
+         * @brief Hashes an operation key from its operation and operand addresses.
+         *
+         */
+        struct key_hash
+        {
+            size_t operator()(const key &k) const
+            {
+                size_t h = std::hash<const void *>()(k.lhs);
+                h ^= std::hash<const void *>()(k.rhs) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+                return h ^ static_cast<size_t>(k.operation);
+            }
+        };
+
+        /**
+         * @brief Every node of the graph, in order of creation.
+         *
+         */
+        std::vector<std::unique_ptr<node>> nodes;
+
+        /**
+         * @brief The nodes of the constants and of the operations, for finding existing ones.
+         *
+         */
+        std::unordered_map<bigint, node *> constants;
+        std::unordered_map<key, node *, key_hash> operations;
+
+        /**
+         * @brief Guards the nodes and the tables above.
+         *
+         */
+        mutable std::mutex build_lock;
+
+        /**
+         * @brief Serializes evaluations, which use the scratch state of the nodes.
+         *
+         */
+        std::mutex evaluate_lock;
+
+        /**
+         * @brief The number of the running evaluation, and the number of operations computed.
+         *
+         */
+        size_t epoch = 0;
+        std::atomic<size_t> computed{0};
+
+        /**
+         * @brief Adds a node to the graph, with the build lock held.
+         *
+         * @param operation The operation
+         * @param lhs The first operand, or null
+         * @param rhs The second operand, or null
+         * @return node* The node
+         */
+        node *create(op operation, node *lhs, node *rhs)
+        {
+            nodes.push_back(std::make_unique<node>());
+            node *n = nodes.back().get();
+            n->operation = operation;
+            n->lhs = lhs;
+            n->rhs = rhs;
+            return n;
+        }
+
+        /**
+         * @brief Returns the node of an operation, creating it if the graph has none.
+         *
+         * @param operation The operation
+         * @param lhs The first operand
+         * @param rhs The second operand, or null
+         * @return node* The node
+         */
+        node *combine(op operation, node *lhs, node *rhs)
+        {
+            // Order the operands of commutative operations, so a + b and b + a are one node
+            if ((operation == op::add || operation == op::multiply) && std::less<node *>()(rhs, lhs))
+                std::swap(lhs, rhs);
+
+            std::lock_guard<std::mutex> guard(build_lock);
+            key k{operation, lhs, rhs};
+            auto it = operations.find(k);
+            if (it != operations.end())
+                return it->second;
+            node *n = create(operation, lhs, rhs);
+            operations.emplace(k, n);
+            return n;
+        }
+
+        /**
+         * @brief Computes the value of a node whose operands have values.
+         *
+         * @param n The node
+         */
+        void compute(node *n)
+        {
+            const bigint &a = n->lhs->value;
+            switch (n->operation)
+            {
+            case op::add:
+                n->value = a + n->rhs->value;
+                break;
+            case op::subtract:
+                n->value = a - n->rhs->value;
+                break;
+            case op::multiply:
+                n->value = a * n->rhs->value;
+                break;
+            case op::divide:
+                n->value = a / n->rhs->value;
+                break;
+            case op::modulo:
+                n->value = a % n->rhs->value;
+                break;
+            case op::negate:
+                n->value = -a;
+                break;
+            case op::constant:
+                break;
+            }
+            n->done.store(true, std::memory_order_release);
+            computed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Computes the values of some nodes and of the nodes they need.
+         *
+         * The nodes without a value are listed operands first by a depth-first
+         * traversal with an explicit stack, so long chains don't recurse. They
+         * are then computed in that order, or on several threads, each node as
+         * soon as its operands have values.
+         *
+         * @param roots The nodes
+         */
+        void run(const std::vector<node *> &roots)
+        {
+            std::lock_guard<std::mutex> guard(evaluate_lock);
+            ++epoch;
+
+            std::vector<node *> order;
+            std::vector<std::pair<node *, bool>> stack;
+            for (node *root : roots)
+                stack.emplace_back(root, false);
+            while (!stack.empty())
+            {
+                auto [n, expanded] = stack.back();
+                stack.pop_back();
+                if (expanded)
+                {
+                    order.push_back(n);
+                    continue;
+                }
+                if (n->mark == epoch || n->done.load(std::memory_order_acquire))
+                    continue;
+                n->mark = epoch;
+                stack.emplace_back(n, true);
+                for (node *operand : {n->rhs, n->lhs})
+                    if (operand && operand->mark != epoch && !operand->done.load(std::memory_order_acquire))
+                        stack.emplace_back(operand, false);
+            }
+
+            size_t threads = std::min(bigint_threads::get_thread_count(), order.size());
+            if (threads <= 1)
+            {
+                for (node *n : order)
+                    compute(n);
+                return;
+            }
+            run_parallel(order, threads);
+        }
+
+        /**
+         * @brief Computes nodes on several threads as their operands get values.
+         *
+         * @param order The nodes without a value, operands first
+         * @param threads The number of threads
+         */
+        void run_parallel(const std::vector<node *> &order, size_t threads)
+        {
+            // Every node is ready once at most, so pushing never allocates while the threads run
+            std::vector<node *> ready;
+            ready.reserve(order.size());
+            for (node *n : order)
+            {
+                n->dependents.clear();
+                size_t pending = 0;
+                // An operand used twice, as in x * x, is counted once
+                for (node *operand : {n->lhs, n->rhs == n->lhs ? nullptr : n->rhs})
+                    if (operand && !operand->done.load(std::memory_order_acquire))
+                    {
+                        operand->dependents.push_back(n);
+                        ++pending;
+                    }
+                n->pending.store(pending, std::memory_order_relaxed);
+                if (pending == 0)
+                    ready.push_back(n);
+            }
+
+            std::mutex queue_lock;
+            std::condition_variable wake;
+            size_t finished = 0;
+            std::exception_ptr error;
+
+            auto work = [&]
+            {
+                std::unique_lock<std::mutex> lock(queue_lock);
+                while (true)
+                {
+                    wake.wait(lock, [&]
+                              { return !ready.empty() || finished == order.size() || error; });
+                    if (ready.empty())
+                        return;
+                    node *n = ready.back();
+                    ready.pop_back();
+                    lock.unlock();
+
+                    std::exception_ptr failure;
+                    try
+                    {
+                        compute(n);
+                    }
+                    catch (...)
+                    {
+                        failure = std::current_exception();
+                    }
+
+                    lock.lock();
+                    if (failure && !error)
+                        error = failure;
+                    if (error)
+                    {
+                        // Stop handing out nodes; the ones running finish on their own
+                        ready.clear();
+                        wake.notify_all();
+                        return;
+                    }
+                    for (node *dependent : n->dependents)
+                        if (dependent->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            ready.push_back(dependent);
+                    ++finished;
+                    wake.notify_all();
+                }
+            };
+
+            bigint_threads::parallel_for(threads, [&](size_t)
+                                         { work(); });
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+
+    /**
+     * @brief Returns the value of the expression, computing it and the subexpressions it needs on the first call.
+     *
+     * @return const bigint& The value, kept until the graph is destroyed
+     */
+    const bigint &value() const
+    {
+        if (!owner)
+            throw std::invalid_argument("Empty expression.");
+        if (!n->done.load(std::memory_order_acquire))
+            owner->run({n});
+        return n->value;
+    }
+
+    /**
+     * @brief Checks if the value of the expression has been computed.
+     *
+     * @return true if it has, or if the expression is a constant
+     * @return false otherwise
+     */
+    bool evaluated() const
+    {
+        return owner && n->done.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Checks if two expressions are the same node.
+     *
+     * The graph creates every node once, so this holds for expressions built
+     * the same way, without comparing any value.
+     *
+     * @param rhs The expression to compare with
+     * @return true if both are the same node
+     * @return false otherwise
+     */
+    bool operator==(const bigint_expr &rhs) const
+    {
+        return n == rhs.n;
+    }
+
+    /**
+     * @brief Checks if two expressions are different nodes.
+     *
+     * @param rhs The expression to compare with
+     * @return true if they are different nodes
+     * @return false otherwise
+     */
+    bool operator!=(const bigint_expr &rhs) const
+    {
+        return n != rhs.n;
+    }
+
+    /**
+     * @brief Arithmetic operators, building the expression of the operation.
+     *
+     * A bigint operand is made a constant of the graph of the expression.
+     *
+     * @param rhs The other operand
+     * @return bigint_expr The expression
+     */
+    bigint_expr operator+(const bigint_expr &rhs) const { return combine(op::add, rhs); }
+    bigint_expr operator-(const bigint_expr &rhs) const { return combine(op::subtract, rhs); }
+    bigint_expr operator*(const bigint_expr &rhs) const { return combine(op::multiply, rhs); }
+    bigint_expr operator/(const bigint_expr &rhs) const { return combine(op::divide, rhs); }
+    bigint_expr operator%(const bigint_expr &rhs) const { return combine(op::modulo, rhs); }
+    bigint_expr operator+(const bigint &rhs) const { return combine(op::add, constant_of(rhs)); }
+    bigint_expr operator-(const bigint &rhs) const { return combine(op::subtract, constant_of(rhs)); }
+    bigint_expr operator*(const bigint &rhs) const { return combine(op::multiply, constant_of(rhs)); }
+    bigint_expr operator/(const bigint &rhs) const { return combine(op::divide, constant_of(rhs)); }
+    bigint_expr operator%(const bigint &rhs) const { return combine(op::modulo, constant_of(rhs)); }
+
+    /**
+     * @brief Returns the expression of the negation.
+     *
+     * @return bigint_expr The expression
+     */
+    bigint_expr operator-() const
+    {
+        if (!owner)
+            throw std::invalid_argument("Empty expression.");
+        return bigint_expr(owner, owner->combine(op::negate, n, nullptr));
+    }
+
+    /**
+     * @brief Compound assignment operators, replacing the expression by the one of the operation.
+     *
+     * @param rhs The other operand
+     * @return bigint_expr& A reference to the current object after the operation
+     */
+    bigint_expr &operator+=(const bigint_expr &rhs) { return *this = *this + rhs; }
+    bigint_expr &operator-=(const bigint_expr &rhs) { return *this = *this - rhs; }
+    bigint_expr &operator*=(const bigint_expr &rhs) { return *this = *this * rhs; }
+
+    /**
+     * @brief Construct a new, empty bigint_expr object, with no value.
+     *
+     */
+    bigint_expr() = default;
+
+private:
+    /**
+     * @brief The graph of the expression, and its node.
+     *
+     */
+    graph *owner = nullptr;
+    node *n = nullptr;
+
+    bigint_expr(graph *g, node *p) : owner(g), n(p) {}
+
+    /**
+     * @brief Returns the expression of an operation of this expression and another one.
+     *
+     * @param operation The operation
+     * @param rhs The other expression, of the same graph
+     * @return bigint_expr The expression
+     */
+    bigint_expr combine(op operation, const bigint_expr &rhs) const
+    {
+        if (!owner || !rhs.owner)
+            throw std::invalid_argument("Empty expression.");
+        if (owner != rhs.owner)
+            throw std::invalid_argument("Expression belongs to another graph.");
+        return bigint_expr(owner, owner->combine(operation, n, rhs.n));
+    }
+
+    /**
+     * @brief Returns the constant of a value in the graph of the expression.
+     *
+     * @param value The value
+     * @return bigint_expr The constant
+     */
+    bigint_expr constant_of(const bigint &value) const
+    {
+        if (!owner)
+            throw std::invalid_argument("Empty expression.");
+        return owner->constant(value);
+    }
+};
+
+#endif // BIGINT_EXPR_HPP
@@ -0,0 +1,494 @@
+/**
+ * @file bigint_file.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_file
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_FILE_HPP
+#define BIGINT_FILE_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/**
+ * @brief Bulk saving and loading of bigint arrays in a columnar binary file
+ *
+ * The file holds a 32-byte header, a column with the signed number of digits
+ * of every value, and, from the next 4096-byte boundary, a column with the
+ * digits of all values one after the other, in the layout of bigint: one byte
+ * per decimal digit, least significant first. Numbers are in the byte order of
+ * the machine.
+ *
+ * Loading sizes the digit vectors of the values from the length column, then
+ * reads the digit column with preadv straight into them: each call fills the
+ * vectors of a batch of values, up to a number of bytes, with no staging copy.
+ * A background thread reads the batches in order while the calling thread
+ * validates the digits of the batches already read, so the checks overlap
+ * the reading.
+ *
+ * Only available on POSIX systems.
+ *
+ */
+class bigint_file
+{
+public:
+    /**
+     * @brief Writes a range of values to a file, replacing its contents.
+     *
+     * @tparam ForwardIt A forward iterator over bigint
+     * @param path The path of the file
+     * @param first The beginning of the range
+     * @param last The end of the range
+     */
+    template <typename ForwardIt>
+    static void save(const std::string &path, ForwardIt first, ForwardIt last)
+    {
+        std::vector<int64_t> lengths;
+        uint64_t total = 0;
+        for (ForwardIt it = first; it != last; ++it)
+        {
+            const bigint &value = *it;
+            lengths.push_back(value.is_negative ? -static_cast<int64_t>(value.vec.size()) : static_cast<int64_t>(value.vec.size()));
+            total += value.vec.size();
+        }
+
+        descriptor file(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644), path);
+        header h = {{'B', 'I', 'G', 'I', 'N', 'T', 'C', '1'}, lengths.size(), total, 0};
+        write_exact(file, &h, sizeof(h), 0, path);
+        if (!lengths.empty())
+            write_exact(file, lengths.data(), lengths.size() * sizeof(int64_t), sizeof(header), path);
+
+        // The digit vectors are gathered by pwritev, like the loader scatters them
+        std::vector<iovec> batch;
+        uint64_t offset = digits_offset(lengths.size()), batch_offset = offset;
+        size_t batch_size = 0;
+        auto flush = [&]
+        {
+            transfer(file, batch, batch_offset, true, path);
+            batch.clear();
+            batch_offset = offset;
+            batch_size = 0;
+        };
+        for (ForwardIt it = first; it != last; ++it)
+        {
+            const bigint &value = *it;
+            batch.push_back({const_cast<uint8_t *>(value.vec.data()), value.vec.size()});
+            batch_size += value.vec.size();
+            offset += value.vec.size();
+            if (batch_size >= default_batch || batch.size() == max_vectors())
+                flush();
+        }
+        if (!batch.empty())
+            flush();
+
+        // Extend the file to the end of the digit column even if it's empty
+        if (ftruncate(file, static_cast<off_t>(offset)) != 0)
+            throw std::runtime_error("Cannot write " + path);
+    }
+
+    /**
+     * @brief Returns the number of values in a file.
+     *
+     * @param path The path of the file
+     * @return size_t The number of values
+     */
+    static size_t count(const std::string &path)
+    {
+        descriptor file(::open(path.c_str(), O_RDONLY), path);
+        return static_cast<size_t>(read_header(file, path).count);
+    }
+
+    /**
+     * @brief Loads every value of a file.
+     *
+     * @param path The path of the file
+     * @param batch_bytes The number of digit bytes read per call
+     * @return std::vector<bigint> The values
+     */
+    static std::vector<bigint> load(const std::string &path, size_t batch_bytes = default_batch)
+    {
+        std::vector<bigint> values(count(path));
+        load(path, values.begin(), values.end(), batch_bytes);
+        return values;
+    }
+
+    /**
+     * @brief Loads the values of a file into a preallocated range, reusing the digit vectors.
+     *
+     * The range must have as many elements as the file has values. If this
+     * throws, every value of the range is set to 0, since the digits read so
+     * far may not have been validated.
+     *
+     * @tparam RandomIt A random-access iterator over bigint
+     * @param path The path of the file
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @param batch_bytes The number of digit bytes read per call
+     */
+    template <typename RandomIt>
+    static void load(const std::string &path, RandomIt first, RandomIt last, size_t batch_bytes = default_batch)
+    {
+        try
+        {
+            load_unchecked(path, first, last, batch_bytes);
+        }
+        catch (...)
+        {
+            // Keep the digit vectors for reuse, but drop the bytes that were read
+            for (RandomIt it = first; it != last; ++it)
+            {
+                it->vec.assign(1, 0);
+                it->is_negative = false;
+            }
+            throw;
+        }
+    }
+
+private:
+    /**
+     * @brief Loads the values of a file into a preallocated range, leaving it partly read on failure.
+     *
+     * @tparam RandomIt A random-access iterator over bigint
+     * @param path The path of the file
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @param batch_bytes The number of digit bytes read per call
+     */
+    template <typename RandomIt>
+    static void load_unchecked(const std::string &path, RandomIt first, RandomIt last, size_t batch_bytes)
+    {
+        descriptor file(::open(path.c_str(), O_RDONLY), path);
+        header h = read_header(file, path);
+        size_t n = static_cast<size_t>(last - first);
+        if (h.count != n)
+            throw std::invalid_argument("The range doesn't match the number of values in " + path);
+
+        std::vector<int64_t> lengths(n);
+        if (n > 0)
+            read_exact(file, lengths.data(), n * sizeof(int64_t), sizeof(header), path);
+
+        // Size every digit vector before reading, so each batch can be scattered into them
+        std::vector<bigint *> values(n);
+        uint64_t total = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t length = lengths[i] < 0 ? uint64_t(0) - static_cast<uint64_t>(lengths[i]) : static_cast<uint64_t>(lengths[i]);
+            // read_header checked the digit count against the file size, so this bounds
+            // the length by the digit bytes the file has left before allocating them
+            if (length == 0 || length > h.digits - total)
+                throw std::invalid_argument("Invalid bigint file: " + path);
+            total += length;
+            values[i] = std::addressof(first[static_cast<std::ptrdiff_t>(i)]);
+            values[i]->vec.resize(static_cast<size_t>(length));
+            values[i]->is_negative = lengths[i] < 0;
+        }
+        if (total != h.digits)
+            throw std::invalid_argument("Invalid bigint file: " + path);
+
+        // Cut the values into batches of about batch_bytes digits
+        std::vector<size_t> ends;
+        for (size_t i = 0, size = 0; i < n; ++i)
+        {
+            size += values[i]->vec.size();
+            if (size >= std::max<size_t>(batch_bytes, 1) || i + 1 == n || (ends.empty() ? i + 1 : i + 1 - ends.back()) == max_vectors())
+            {
+                ends.push_back(i + 1);
+                size = 0;
+            }
+        }
+        uint64_t start = digits_offset(n);
+        auto read_batch = [&](size_t begin, size_t end, uint64_t offset)
+        {
+            std::vector<iovec> batch;
+            batch.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i)
+                batch.push_back({values[i]->vec.data(), values[i]->vec.size()});
+            transfer(file, batch, offset, false, path);
+        };
+
+        if (ends.size() <= 1)
+        {
+            if (n > 0)
+                read_batch(0, n, start);
+            check(values, 0, n, path);
+            return;
+        }
+
+        // The reader thread publishes how many values are read; this thread checks them
+        std::mutex lock;
+        std::condition_variable progress;
+        size_t ready = 0;
+        bool failed = false, stop = false;
+        std::thread reader([&]
+                           {
+                               uint64_t offset = start;
+                               size_t begin = 0;
+                               for (size_t end : ends)
+                               {
+                                   bool ok = true;
+                                   try
+                                   {
+                                       read_batch(begin, end, offset);
+                                   }
+                                   catch (...)
+                                   {
+                                       ok = false;
+                                   }
+                                   for (size_t i = begin; i < end; ++i)
+                                       offset += values[i]->vec.size();
+                                   std::lock_guard<std::mutex> guard(lock);
+                                   failed = !ok;
+                                   if (ok)
+                                       ready = end;
+                                   progress.notify_one();
+                                   if (failed || stop)
+                                       return;
+                                   begin = end;
+                               } });
+
+        size_t checked = 0;
+        bool invalid = false, io_error = false;
+        while (checked < n && !invalid && !io_error)
+        {
+            size_t available;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                progress.wait(guard, [&]
+                              { return ready > checked || failed; });
+                available = ready;
+                io_error = failed && ready == checked;
+            }
+            try
+            {
+                check(values, checked, available, path);
+            }
+            catch (const std::invalid_argument &)
+            {
+                invalid = true;
+            }
+            checked = available;
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stop = true;
+        }
+        reader.join();
+        if (io_error)
+            throw std::runtime_error("Cannot read " + path);
+        if (invalid)
+            throw std::invalid_argument("Invalid bigint file: " + path);
+    }
+
+    /**
+     * @brief The start of a file.
+     *
+     */
+    struct header
+    {
+        char magic[8];
+        uint64_t count;
+        uint64_t digits;
+        uint64_t reserved;
+    };
+
+    /**
+     * @brief The default number of digit bytes per read or write call.
+     *
+     */
+    static constexpr size_t default_batch = size_t(1) << 20;
+
+    /**
+     * @brief The alignment of the digit column in the file.
+     *
+     */
+    static constexpr uint64_t alignment = 4096;
+
+    /**
+     * @brief A file descriptor closed on destruction.
+     *
+     */
+    struct descriptor
+    {
+        descriptor(int file, const std::string &path) : fd(file)
+        {
+            if (fd < 0)
+                throw std::runtime_error("Cannot open " + path);
+        }
+        descriptor(const descriptor &) = delete;
+        descriptor &operator=(const descriptor &) = delete;
+        ~descriptor()
+        {
+            close(fd);
+        }
+        operator int() const
+        {
+            return fd;
+        }
+
+        int fd;
+    };
+
+    /**
+     * @brief Returns the offset of the digit column of a file with some values.
+     *
+     * @param count The number of values
+     * @return uint64_t The offset, the end of the length column rounded up to the alignment
+     */
+    static uint64_t digits_offset(uint64_t count)
+    {
+        return (sizeof(header) + count * sizeof(int64_t) + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Returns the largest number of buffers a preadv or pwritev call takes.
+     *
+     * @return size_t The number of buffers
+     */
+    static size_t max_vectors()
+    {
+        static const size_t limit = static_cast<size_t>(std::max(sysconf(_SC_IOV_MAX), 16L));
+        return limit;
+    }
+
+    /**
+     * @brief Reads and checks the header of a file.
+     *
+     * @param fd The descriptor of the file
+     * @param path The path of the file, for errors
+     * @return header The header
+     */
+    static header read_header(int fd, const std::string &path)
+    {
+        header h;
+        struct stat status;
+        if (fstat(fd, &status) != 0)
+            throw std::runtime_error("Cannot read " + path);
+        if (static_cast<uint64_t>(status.st_size) < sizeof(header))
+            throw std::invalid_argument("Invalid bigint file: " + path);
+        read_exact(fd, &h, sizeof(h), 0, path);
+        // The digit column must fit in the file, which bounds every length read later
+        uint64_t size = static_cast<uint64_t>(status.st_size);
+        if (std::memcmp(h.magic, "BIGINTC1", 8) != 0 || h.count > (size - sizeof(header)) / sizeof(int64_t) ||
+            size < digits_offset(h.count) || h.digits > size - digits_offset(h.count))
+            throw std::invalid_argument("Invalid bigint file: " + path);
+        return h;
+    }
+
+    /**
+     * @brief Reads bytes at an offset, retrying short reads.
+     *
+     * @param fd The descriptor of the file
+     * @param data The destination
+     * @param size The number of bytes
+     * @param offset The offset in the file
+     * @param path The path of the file, for errors
+     */
+    static void read_exact(int fd, void *data, size_t size, uint64_t offset, const std::string &path)
+    {
+        std::vector<iovec> one = {{data, size}};
+        transfer(fd, one, offset, false, path);
+    }
+
+    /**
+     * @brief Writes bytes at an offset, retrying short writes.
+     *
+     * @param fd The descriptor of the file
+     * @param data The source
+     * @param size The number of bytes
+     * @param offset The offset in the file
+     * @param path The path of the file, for errors
+     */
+    static void write_exact(int fd, const void *data, size_t size, uint64_t offset, const std::string &path)
+    {
+        std::vector<iovec> one = {{const_cast<void *>(data), size}};
+        transfer(fd, one, offset, true, path);
+    }
+
+    /**
+     * @brief Reads or writes a list of buffers at consecutive offsets with preadv or pwritev.
+     *
+     * Short transfers are resumed where they stopped, so every buffer is
+     * transferred in full.
+     *
+     * @param fd The descriptor of the file
+     * @param buffers The buffers, consumed by the transfer
+     * @param offset The offset of the first buffer in the file
+     * @param write Whether to write rather than read
+     * @param path The path of the file, for errors
+     */
+    static void transfer(int fd, std::vector<iovec> &buffers, uint64_t offset, bool write, const std::string &path)
+    {
+        size_t first = 0;
+        while (first < buffers.size())
+        {
+            if (buffers[first].iov_len == 0)
+            {
+                ++first;
+                continue;
+            }
+            int count = static_cast<int>(std::min(buffers.size() - first, max_vectors()));
+            ssize_t done = write ? pwritev(fd, buffers.data() + first, count, static_cast<off_t>(offset))
+                                 : preadv(fd, buffers.data() + first, count, static_cast<off_t>(offset));
+            if (done < 0 && errno == EINTR)
+                continue;
+            if (done <= 0)
+                throw std::runtime_error((write ? "Cannot write " : "Cannot read ") + path);
+            offset += static_cast<uint64_t>(done);
+            for (size_t left = static_cast<size_t>(done); left > 0;)
+            {
+                size_t step = std::min(left, buffers[first].iov_len);
+                buffers[first].iov_base = static_cast<uint8_t *>(buffers[first].iov_base) + step;
+                buffers[first].iov_len -= step;
+                left -= step;
+                if (buffers[first].iov_len == 0)
+                    ++first;
+            }
+        }
+    }
+
+    /**
+     * @brief Checks that values read from a file are in canonical form.
+     *
+     * Every byte must be a decimal digit, the most significant digit of a value
+     * with several digits must not be zero, and zero must not be negative.
+     *
+     * @param values The values
+     * @param begin The first value to check
+     * @param end The end of the values to check
+     * @param path The path of the file, for errors
+     */
+    static void check(const std::vector<bigint *> &values, size_t begin, size_t end, const std::string &path)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const std::vector<uint8_t> &digits = values[i]->vec;
+            uint8_t invalid = 0;
+            for (uint8_t d : digits)
+                invalid |= static_cast<uint8_t>(d > 9);
+            if (invalid || (digits.size() > 1 && digits.back() == 0) || (digits.size() == 1 && digits[0] == 0 && values[i]->is_negative))
+                throw std::invalid_argument("Invalid bigint file: " + path);
+        }
+    }
+};
+
+#endif // BIGINT_FILE_HPP
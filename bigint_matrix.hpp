@@ -0,0 +1,749 @@
+/**
+ * @file bigint_matrix.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_matrix
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_MATRIX_HPP
+#define BIGINT_MATRIX_HPP
+
+#include "bigint.hpp"
+#include "bigint_threads.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A class for dense matrices with bigint entries
+ *
+ * The entries are stored row by row. Multiplication picks one of three methods:
+ * a cache-blocked triple loop, Strassen-Winograd for square matrices with large
+ * entries, and
+ * a multi-modular method that multiplies residue matrices modulo word-sized
+ * primes on several threads and reconstructs the entries by the Chinese
+ * remainder theorem.
+ *
+ */
+class bigint_matrix
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * Outputs one row per line, with the entries separated by spaces.
+     *
+     * @param out an instance of std::ostream
+     * @param m the bigint_matrix object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const bigint_matrix &m)
+    {
+        for (size_t i = 0; i < m.r; ++i)
+        {
+            for (size_t j = 0; j < m.c; ++j)
+                out << (j == 0 ? "" : " ") << m(i, j);
+            out << '\n';
+        }
+        return out;
+    }
+
+public:
+    /**
+     * @brief Checks if two matrices are equal
+     *
+     * @param rhs The matrix to compare with
+     * @return true if both matrices have the same shape and entries
+     * @return false otherwise
+     */
+    bool operator==(const bigint_matrix &rhs) const
+    {
+        return r == rhs.r && c == rhs.c && data == rhs.data;
+    }
+
+    /**
+     * @brief Check if two matrices are not equal
+     *
+     * @param rhs The matrix to compare with
+     * @return true if the matrices are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const bigint_matrix &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Adds two matrices
+     *
+     * @param rhs The matrix to add to the current matrix
+     * @return bigint_matrix A new one representing the sum
+     * @throws std::invalid_argument if the shapes differ
+     */
+    bigint_matrix operator+(const bigint_matrix &rhs) const
+    {
+        if (r != rhs.r || c != rhs.c)
+            throw std::invalid_argument("Matrix dimensions don't match");
+        bigint_matrix sum(*this);
+        for (size_t i = 0; i < data.size(); ++i)
+            sum.data[i] += rhs.data[i];
+        return sum;
+    }
+
+    /**
+     * @brief Subtracts the given matrix from the current matrix
+     *
+     * @param rhs The matrix to subtract
+     * @return bigint_matrix A new one representing the difference
+     * @throws std::invalid_argument if the shapes differ
+     */
+    bigint_matrix operator-(const bigint_matrix &rhs) const
+    {
+        if (r != rhs.r || c != rhs.c)
+            throw std::invalid_argument("Matrix dimensions don't match");
+        bigint_matrix difference(*this);
+        for (size_t i = 0; i < data.size(); ++i)
+            difference.data[i] -= rhs.data[i];
+        return difference;
+    }
+
+    /**
+     * @brief Multiplies two matrices
+     *
+     * Uses the multi-modular method once the inner dimension reaches
+     * multimodular_threshold, unless the entries have more than 40 digits per unit
+     * of inner dimension: the residues and the reconstruction grow with the square
+     * of the entry size, while the products only grow with the dimension. Square
+     * matrices with entries of at least strassen_threshold digits use
+     * Strassen-Winograd, and everything else the blocked triple loop.
+     *
+     * @param rhs The matrix to multiply with the current matrix
+     * @return bigint_matrix A new one representing the product
+     * @throws std::invalid_argument if the inner dimensions differ
+     */
+    bigint_matrix operator*(const bigint_matrix &rhs) const
+    {
+        if (c != rhs.r)
+            throw std::invalid_argument("Matrix dimensions don't match");
+        size_t digits = std::max(max_digits(), rhs.max_digits());
+        if (c >= multimodular_threshold && digits <= 40 * c)
+            return multiply_multimodular(*this, rhs);
+        if (r == c && c == rhs.c && digits >= strassen_threshold)
+            return multiply_strassen(*this, rhs);
+        return multiply_blocked(*this, rhs);
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return bigint_matrix& A reference to the current object after the operation
+     */
+    bigint_matrix &operator+=(const bigint_matrix &rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return bigint_matrix& A reference to the current object after the operation
+     */
+    bigint_matrix &operator-=(const bigint_matrix &rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return bigint_matrix& A reference to the current object after the operation
+     */
+    bigint_matrix &operator*=(const bigint_matrix &rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return bigint_matrix A negated matrix
+     */
+    bigint_matrix operator-() const
+    {
+        bigint_matrix negated(*this);
+        for (bigint &entry : negated.data)
+            entry = -entry;
+        return negated;
+    }
+
+    /**
+     * @brief Returns the entry at row i and column j.
+     *
+     * @param i The row
+     * @param j The column
+     * @return bigint& The entry
+     */
+    bigint &operator()(size_t i, size_t j)
+    {
+        return data[i * c + j];
+    }
+
+    /**
+     * @brief Returns the entry at row i and column j.
+     *
+     * @param i The row
+     * @param j The column
+     * @return const bigint& The entry
+     */
+    const bigint &operator()(size_t i, size_t j) const
+    {
+        return data[i * c + j];
+    }
+
+    /**
+     * @brief Returns the number of rows.
+     *
+     * @return size_t The number of rows
+     */
+    size_t rows() const
+    {
+        return r;
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     *
+     * @return size_t The number of columns
+     */
+    size_t cols() const
+    {
+        return c;
+    }
+
+    /**
+     * @brief Returns the identity matrix.
+     *
+     * @param n The number of rows and columns
+     * @return bigint_matrix The n x n identity matrix
+     */
+    static bigint_matrix identity(size_t n)
+    {
+        bigint_matrix m(n, n);
+        for (size_t i = 0; i < n; ++i)
+            m(i, i) = 1;
+        return m;
+    }
+
+    /**
+     * @brief Multiplies two matrices with a cache-blocked triple loop.
+     *
+     * The loops run over tiles so that a tile of each operand stays in cache, and
+     * every product is accumulated into its entry with bigint::addmul().
+     *
+     * @param a The first matrix
+     * @param b The second matrix
+     * @return bigint_matrix The product
+     * @throws std::invalid_argument if the inner dimensions differ
+     */
+    static bigint_matrix multiply_blocked(const bigint_matrix &a, const bigint_matrix &b)
+    {
+        if (a.c != b.r)
+            throw std::invalid_argument("Matrix dimensions don't match");
+
+        const size_t block = 16;
+        bigint_matrix product(a.r, b.c);
+        for (size_t ii = 0; ii < a.r; ii += block)
+            for (size_t kk = 0; kk < a.c; kk += block)
+                for (size_t jj = 0; jj < b.c; jj += block)
+                    for (size_t i = ii; i < std::min(ii + block, a.r); ++i)
+                        for (size_t k = kk; k < std::min(kk + block, a.c); ++k)
+                        {
+                            const bigint &x = a(i, k);
+                            if (x == 0)
+                                continue;
+                            for (size_t j = jj; j < std::min(jj + block, b.c); ++j)
+                                product(i, j).addmul(x, b(k, j));
+                        }
+        return product;
+    }
+
+    /**
+     * @brief Multiplies two matrices with the Strassen-Winograd recursion.
+     *
+     * Each level splits both matrices into quadrants and forms the product with 7
+     * quadrant products and 15 additions instead of 8 products, which pays off as
+     * a product of entries costs much more than a sum. The operands are padded
+     * with zeros to an even square size where needed, and the recursion goes down
+     * to single entries.
+     *
+     * @param a The first matrix
+     * @param b The second matrix
+     * @return bigint_matrix The product
+     * @throws std::invalid_argument if the inner dimensions differ
+     */
+    static bigint_matrix multiply_strassen(const bigint_matrix &a, const bigint_matrix &b)
+    {
+        if (a.c != b.r)
+            throw std::invalid_argument("Matrix dimensions don't match");
+
+        size_t n = std::max({a.r, a.c, b.c});
+        if (a.r == n && a.c == n && b.c == n)
+            return strassen_square(a, b);
+        return strassen_square(a.resized(n, n), b.resized(n, n)).resized(a.r, b.c);
+    }
+
+    /**
+     * @brief Multiplies two matrices by multi-modular arithmetic.
+     *
+     * The entries are reduced modulo enough primes below 2^31 that their product
+     * exceeds twice the largest possible entry of the result. The residue matrices
+     * are multiplied with 64-bit accumulators, one prime per task, and every entry
+     * is rebuilt from its residues with Garner's algorithm. Both the products and
+     * the reconstruction are split across bigint_threads::get_thread_count() threads.
+     *
+     * @param a The first matrix
+     * @param b The second matrix
+     * @return bigint_matrix The product
+     * @throws std::invalid_argument if the inner dimensions differ
+     */
+    static bigint_matrix multiply_multimodular(const bigint_matrix &a, const bigint_matrix &b)
+    {
+        if (a.c != b.r)
+            throw std::invalid_argument("Matrix dimensions don't match");
+        if (a.data.empty() || b.data.empty())
+            return bigint_matrix(a.r, b.c);
+
+        // |entry| <= inner * max|a| * max|b| < 10^bound / 2
+        size_t bound = a.max_digits() + b.max_digits() + std::to_string(a.c).size() + 1;
+        std::vector<uint32_t> primes = select_primes(bound);
+        size_t count = primes.size();
+
+        std::vector<std::vector<uint32_t>> a_chunks = a.chunks(), b_chunks = b.chunks();
+        std::vector<std::vector<uint32_t>> products(count);
+        bigint_threads::parallel_for(count, [&](size_t t)
+                     { products[t] = residue_product(a, a_chunks, b, b_chunks, primes[t]); });
+
+        // Garner's constants: inverses[i][j] = p_j^-1 mod p_i for j < i
+        std::vector<std::vector<uint32_t>> inverses(count);
+        for (size_t i = 0; i < count; ++i)
+            for (size_t j = 0; j < i; ++j)
+                inverses[i].push_back(inverse_mod(primes[j] % primes[i], primes[i]));
+
+        bigint modulus(1);
+        for (uint32_t p : primes)
+            modulus = modulus * bigint(static_cast<int64_t>(p));
+
+        bigint_matrix product(a.r, b.c);
+        bigint_threads::parallel_for(product.data.size(), [&](size_t e)
+                     {
+                         std::vector<uint32_t> mixed(count);
+                         for (size_t i = 0; i < count; ++i)
+                         {
+                             uint64_t x = products[i][e];
+                             for (size_t j = 0; j < i; ++j)
+                                 x = (x + primes[i] - mixed[j] % primes[i]) % primes[i] * inverses[i][j] % primes[i];
+                             mixed[i] = static_cast<uint32_t>(x);
+                         }
+
+                         bigint value(static_cast<int64_t>(mixed[count - 1]));
+                         for (size_t i = count - 1; i > 0; --i)
+                         {
+                             value = value * bigint(static_cast<int64_t>(primes[i - 1]));
+                             value += bigint(static_cast<int64_t>(mixed[i - 1]));
+                         }
+                         if (value + value > modulus)
+                             value -= modulus;
+                         product.data[e] = std::move(value); });
+        return product;
+    }
+
+    /**
+     * @brief Sets the entry size from which square products use Strassen-Winograd.
+     *
+     * @param digits The new threshold in decimal digits
+     */
+    static void set_strassen_threshold(size_t digits)
+    {
+        strassen_threshold = digits;
+    }
+
+    /**
+     * @brief Returns the entry size from which square products use Strassen-Winograd.
+     *
+     * @return size_t The threshold in decimal digits
+     */
+    static size_t get_strassen_threshold()
+    {
+        return strassen_threshold;
+    }
+
+    /**
+     * @brief Sets the inner dimension from which multiplication uses the multi-modular method.
+     *
+     * @param inner The new threshold
+     */
+    static void set_multimodular_threshold(size_t inner)
+    {
+        multimodular_threshold = inner;
+    }
+
+    /**
+     * @brief Returns the inner dimension from which multiplication uses the multi-modular method.
+     *
+     * @return size_t The threshold
+     */
+    static size_t get_multimodular_threshold()
+    {
+        return multimodular_threshold;
+    }
+
+    /**
+     * @brief Sets the number of threads used by the multi-modular method.
+     *
+     * The count is the one shared by all parallel classes, as for
+     * bigint_threads::set_thread_count().
+     *
+     * @param threads The number of threads, 1 for none (at least 1)
+     */
+    static void set_thread_count(size_t threads)
+    {
+        bigint_threads::set_thread_count(threads);
+    }
+
+    /**
+     * @brief Returns the number of threads used by the multi-modular method.
+     *
+     * @return size_t The number of threads
+     */
+    static size_t get_thread_count()
+    {
+        return bigint_threads::get_thread_count();
+    }
+
+    /**
+     * @brief Construct a new bigint_matrix object with no rows and columns.
+     *
+     */
+    bigint_matrix() : r(0), c(0) {}
+
+    /**
+     * @brief Construct a new bigint_matrix object filled with zeros.
+     *
+     * @param rows The number of rows
+     * @param cols The number of columns
+     */
+    bigint_matrix(size_t rows, size_t cols) : r(rows), c(cols), data(rows * cols, bigint(0)) {}
+
+    /**
+     * @brief Construct a new bigint_matrix object from its entries.
+     *
+     * @param rows The number of rows
+     * @param cols The number of columns
+     * @param entries The entries row by row
+     * @throws std::invalid_argument if there are not rows * cols entries
+     */
+    bigint_matrix(size_t rows, size_t cols, std::vector<bigint> entries) : r(rows), c(cols), data(std::move(entries))
+    {
+        if (data.size() != rows * cols)
+            throw std::invalid_argument("Matrix dimensions don't match");
+    }
+
+private:
+    /**
+     * @brief The number of rows.
+     *
+     */
+    size_t r;
+
+    /**
+     * @brief The number of columns.
+     *
+     */
+    size_t c;
+
+    /**
+     * @brief The entries row by row.
+     *
+     */
+    std::vector<bigint> data;
+
+    /**
+     * @brief The entry size from which square products use Strassen-Winograd.
+     *
+     * Strassen-Winograd trades one product of entries for several sums, so the
+     * crossover depends on the entry size rather than on the dimension.
+     *
+     */
+    inline static size_t strassen_threshold = 40;
+
+    /**
+     * @brief The inner dimension from which multiplication uses the multi-modular method.
+     *
+     */
+    inline static size_t multimodular_threshold = 8;
+
+    /**
+     * @brief Returns a copy cut or padded with zeros to the given shape.
+     *
+     * @param rows The number of rows
+     * @param cols The number of columns
+     * @return bigint_matrix The resized copy
+     */
+    bigint_matrix resized(size_t rows, size_t cols) const
+    {
+        bigint_matrix m(rows, cols);
+        for (size_t i = 0; i < std::min(rows, r); ++i)
+            for (size_t j = 0; j < std::min(cols, c); ++j)
+                m(i, j) = (*this)(i, j);
+        return m;
+    }
+
+    /**
+     * @brief Copies the quadrant starting at the given row and column.
+     *
+     * @param row The first row
+     * @param col The first column
+     * @param n The size of the quadrant
+     * @return bigint_matrix The quadrant
+     */
+    bigint_matrix quadrant(size_t row, size_t col, size_t n) const
+    {
+        bigint_matrix m(n, n);
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                m(i, j) = (*this)(row + i, col + j);
+        return m;
+    }
+
+    /**
+     * @brief Copies a matrix into the current one at the given row and column.
+     *
+     * @param row The first row
+     * @param col The first column
+     * @param m The matrix to copy
+     */
+    void place(size_t row, size_t col, const bigint_matrix &m)
+    {
+        for (size_t i = 0; i < m.r; ++i)
+            for (size_t j = 0; j < m.c; ++j)
+                (*this)(row + i, col + j) = m(i, j);
+    }
+
+    /**
+     * @brief The Strassen-Winograd recursion on two n x n matrices.
+     *
+     * @param a The first matrix
+     * @param b The second matrix
+     * @return bigint_matrix The product
+     */
+    static bigint_matrix strassen_square(const bigint_matrix &a, const bigint_matrix &b)
+    {
+        size_t n = a.r;
+        if (n < 2)
+            return multiply_blocked(a, b);
+        if (n % 2 == 1)
+            return strassen_square(a.resized(n + 1, n + 1), b.resized(n + 1, n + 1)).resized(n, n);
+
+        size_t h = n / 2;
+        bigint_matrix a11 = a.quadrant(0, 0, h), a12 = a.quadrant(0, h, h), a21 = a.quadrant(h, 0, h), a22 = a.quadrant(h, h, h);
+        bigint_matrix b11 = b.quadrant(0, 0, h), b12 = b.quadrant(0, h, h), b21 = b.quadrant(h, 0, h), b22 = b.quadrant(h, h, h);
+
+        bigint_matrix s1 = a21 + a22, s2 = s1 - a11, s3 = a11 - a21, s4 = a12 - s2;
+        bigint_matrix t1 = b12 - b11, t2 = b22 - t1, t3 = b22 - b12, t4 = t2 - b21;
+
+        bigint_matrix p1 = strassen_square(a11, b11);
+        bigint_matrix p2 = strassen_square(a12, b21);
+        bigint_matrix p3 = strassen_square(s4, b22);
+        bigint_matrix p4 = strassen_square(a22, t4);
+        bigint_matrix p5 = strassen_square(s1, t1);
+        bigint_matrix p6 = strassen_square(s2, t2);
+        bigint_matrix p7 = strassen_square(s3, t3);
+
+        bigint_matrix u2 = p1 + p6, u3 = u2 + p7, u4 = u2 + p5;
+        bigint_matrix product(n, n);
+        product.place(0, 0, p1 + p2);
+        product.place(0, h, u4 + p3);
+        product.place(h, 0, u3 - p4);
+        product.place(h, h, u3 + p5);
+        return product;
+    }
+
+    /**
+     * @brief Returns the digit count of the largest entry.
+     *
+     * @return size_t The number of digits
+     */
+    size_t max_digits() const
+    {
+        size_t digits = 0;
+        for (const bigint &entry : data)
+            digits = std::max(digits, entry.digits());
+        return digits;
+    }
+
+    /**
+     * @brief Splits every entry into base 10^9 chunks, most significant first.
+     *
+     * The chunks are shared by all primes, so each entry is read digit by digit
+     * only once. A negative entry gets an extra leading marker chunk 10^9.
+     *
+     * @return std::vector<std::vector<uint32_t>> The chunks of every entry
+     */
+    std::vector<std::vector<uint32_t>> chunks() const
+    {
+        std::vector<std::vector<uint32_t>> result;
+        result.reserve(data.size());
+        for (const bigint &entry : data)
+        {
+            std::vector<uint32_t> chunk_list;
+            if (entry < 0)
+                chunk_list.push_back(1000000000);
+            for (size_t i = (entry.digits() + 8) / 9; i > 0; --i)
+            {
+                uint32_t chunk = 0;
+                for (size_t j = 9; j > 0; --j)
+                    chunk = chunk * 10 + entry.digit((i - 1) * 9 + j - 1);
+                chunk_list.push_back(chunk);
+            }
+            result.push_back(std::move(chunk_list));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Multiplies two matrices modulo a prime.
+     *
+     * The residues are below 2^31, so three products and a reduced value add up
+     * to less than 2^64 and the accumulators are reduced every third step. The
+     * inner loop runs along a row of the result, which compilers vectorize.
+     *
+     * @param a The first matrix
+     * @param a_chunks The chunks of the entries of a
+     * @param b The second matrix
+     * @param b_chunks The chunks of the entries of b
+     * @param p The prime
+     * @return std::vector<uint32_t> The residues of the product, row by row
+     */
+    static std::vector<uint32_t> residue_product(const bigint_matrix &a, const std::vector<std::vector<uint32_t>> &a_chunks,
+                                                 const bigint_matrix &b, const std::vector<std::vector<uint32_t>> &b_chunks, uint32_t p)
+    {
+        std::vector<uint64_t> a_res = residues(a_chunks, p), b_res = residues(b_chunks, p);
+        std::vector<uint32_t> product(a.r * b.c);
+        std::vector<uint64_t> row(b.c);
+        for (size_t i = 0; i < a.r; ++i)
+        {
+            std::fill(row.begin(), row.end(), 0);
+            for (size_t k = 0; k < a.c; ++k)
+            {
+                uint64_t x = a_res[i * a.c + k];
+                const uint64_t *b_row = b_res.data() + k * b.c;
+                for (size_t j = 0; j < b.c; ++j)
+                    row[j] += x * b_row[j];
+                if (k % 3 == 2)
+                    for (uint64_t &value : row)
+                        value %= p;
+            }
+            for (size_t j = 0; j < b.c; ++j)
+                product[i * b.c + j] = static_cast<uint32_t>(row[j] % p);
+        }
+        return product;
+    }
+
+    /**
+     * @brief Reduces chunked entries modulo a prime.
+     *
+     * @param chunks The chunks of every entry
+     * @param p The prime
+     * @return std::vector<uint64_t> The residues in [0, p)
+     */
+    static std::vector<uint64_t> residues(const std::vector<std::vector<uint32_t>> &chunks, uint32_t p)
+    {
+        std::vector<uint64_t> result;
+        result.reserve(chunks.size());
+        for (const std::vector<uint32_t> &chunk_list : chunks)
+        {
+            bool negative = !chunk_list.empty() && chunk_list[0] == 1000000000;
+            uint64_t residue = 0;
+            for (size_t i = negative ? 1 : 0; i < chunk_list.size(); ++i)
+                residue = (residue * 1000000000 + chunk_list[i]) % p;
+            result.push_back(negative && residue != 0 ? p - residue : residue);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Picks primes below 2^31 whose product has more than the given number of digits.
+     *
+     * The primes are found once, from 2^31 - 1 downwards, together with the number
+     * of digits of the product of each prefix. Every call shares them and only
+     * extends them when it needs more primes than any call before.
+     *
+     * @param digits The number of digits the product must exceed
+     * @return std::vector<uint32_t> The primes, largest first
+     */
+    static std::vector<uint32_t> select_primes(size_t digits)
+    {
+        struct prime_cache
+        {
+            std::mutex lock;
+            std::vector<uint32_t> primes;
+            std::vector<size_t> product_digits;
+            bigint product = bigint(1);
+            uint32_t next = 2147483647;
+        };
+        static prime_cache cache;
+
+        std::lock_guard<std::mutex> guard(cache.lock);
+        while (cache.product.digits() <= digits)
+        {
+            uint32_t candidate = cache.next;
+            cache.next -= 2;
+            bool prime = true;
+            for (uint32_t d = 3; static_cast<uint64_t>(d) * d <= candidate && prime; d += 2)
+                prime = candidate % d != 0;
+            if (!prime)
+                continue;
+            cache.primes.push_back(candidate);
+            cache.product *= bigint(static_cast<int64_t>(candidate));
+            cache.product_digits.push_back(cache.product.digits());
+        }
+        // The shortest prefix whose product has more than digits digits
+        size_t count = static_cast<size_t>(std::upper_bound(cache.product_digits.begin(), cache.product_digits.end(), digits) - cache.product_digits.begin()) + 1;
+        return std::vector<uint32_t>(cache.primes.begin(), cache.primes.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    /**
+     * @brief Computes the inverse of a modulo a prime by the extended Euclidean algorithm.
+     *
+     * @param a The value, not divisible by p
+     * @param p The prime
+     * @return uint32_t The inverse in [0, p)
+     */
+    static uint32_t inverse_mod(uint32_t a, uint32_t p)
+    {
+        int64_t t0 = 0, t1 = 1;
+        int64_t r0 = p, r1 = a;
+        while (r1 != 0)
+        {
+            int64_t q = r0 / r1;
+            r0 = std::exchange(r1, r0 - q * r1);
+            t0 = std::exchange(t1, t0 - q * t1);
+        }
+        return static_cast<uint32_t>(t0 < 0 ? t0 + p : t0);
+    }
+};
+
+#endif // BIGINT_MATRIX_HPP
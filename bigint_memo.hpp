@@ -0,0 +1,520 @@
+/**
+ * @file bigint_memo.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_memo
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_MEMO_HPP
+#define BIGINT_MEMO_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A thread-safe, bounded cache of factorials, binomial coefficients and powers
+ *
+ * Every result is kept with the number of bytes it uses, and the least recently
+ * used results are evicted once their total exceeds the capacity. A factorial
+ * or a power that isn't cached starts from the largest cached one below it, so
+ * computing (n + 1)! after n! costs a single multiplication, and b^e after
+ * b^(e - d) costs the power b^d and one multiplication.
+ *
+ * The lock is only held to look up and store results, not while computing
+ * them, so threads missing the same value at the same time may both compute it.
+ *
+ */
+class bigint_memo
+{
+public:
+    /**
+     * @brief Counts of the lookups and the contents of the cache.
+     *
+     */
+    struct statistics
+    {
+        /**
+         * @brief The number of results found in the cache.
+         *
+         */
+        size_t hits = 0;
+
+        /**
+         * @brief The number of results computed, and how many of them started from a smaller cached one.
+         *
+         */
+        size_t misses = 0;
+        size_t reuses = 0;
+
+        /**
+         * @brief The number of results evicted to stay within the capacity.
+         *
+         */
+        size_t evictions = 0;
+
+        /**
+         * @brief The number of results cached, and the bytes they use.
+         *
+         */
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    /**
+     * @brief Returns n!.
+     *
+     * @param n The argument
+     * @return bigint The factorial
+     */
+    bigint factorial(uint64_t n)
+    {
+        return memoize({kind::factorial, bigint(0), n, 0}, [&](const key *below, const bigint *value)
+                       {
+                           uint64_t from = below ? below->n : 0;
+                           bigint result = product(range_words(from + 1, n));
+                           return below ? result * *value : result; });
+    }
+
+    /**
+     * @brief Returns the binomial coefficient C(n, k), 0 for k > n.
+     *
+     * C(n, k) and C(n, n - k) share their entry.
+     *
+     * @param n The size of the set
+     * @param k The size of the subsets
+     * @return bigint The number of subsets of size k of a set of size n
+     */
+    bigint binomial(uint64_t n, uint64_t k)
+    {
+        if (k > n)
+            return bigint(0);
+        k = std::min(k, n - k);
+        return memoize({kind::binomial, bigint(0), n, k}, [&](const key *, const bigint *)
+                       { return product(binomial_words(n, k)); });
+    }
+
+    /**
+     * @brief Returns 10^exponent.
+     *
+     * The digits are stored in base 10, so this only writes the digits and
+     * isn't cached: a cached copy would cost as much.
+     *
+     * @param exponent The exponent
+     * @return bigint The power of ten
+     */
+    bigint pow10(uint64_t exponent) const
+    {
+        return bigint(1).shift10(static_cast<int64_t>(exponent));
+    }
+
+    /**
+     * @brief Returns base^exponent, with 0^0 = 1.
+     *
+     * @param base The base
+     * @param exponent The exponent
+     * @return bigint The power
+     */
+    bigint pow(const bigint &base, uint64_t exponent)
+    {
+        if (base == 10)
+            return pow10(exponent);
+        return memoize({kind::power, base, exponent, 0}, [&](const key *below, const bigint *value)
+                       {
+                           if (!below)
+                               return power(base, exponent);
+                           return *value * power(base, exponent - below->n); });
+    }
+
+    /**
+     * @brief Returns the lookup counts and the contents of the cache.
+     *
+     * @return statistics The statistics
+     */
+    statistics stats() const
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        statistics s = counts;
+        s.entries = entries.size();
+        s.bytes = used;
+        return s;
+    }
+
+    /**
+     * @brief Sets the number of bytes the cached results may use, evicting results beyond it.
+     *
+     * @param bytes The capacity, 0 to cache nothing
+     */
+    void set_capacity(size_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        limit = bytes;
+        evict();
+    }
+
+    /**
+     * @brief Returns the number of bytes the cached results may use.
+     *
+     * @return size_t The capacity
+     */
+    size_t capacity() const
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return limit;
+    }
+
+    /**
+     * @brief Removes every result and resets the statistics.
+     *
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        entries.clear();
+        order.clear();
+        used = 0;
+        counts = statistics();
+    }
+
+    /**
+     * @brief Returns a process-wide cache.
+     *
+     * @return bigint_memo& The cache, with a capacity of 64 MiB, alive until the program exits
+     */
+    static bigint_memo &global()
+    {
+        static bigint_memo memo;
+        return memo;
+    }
+
+    /**
+     * @brief Construct a new bigint_memo object.
+     *
+     * @param bytes The number of bytes the cached results may use
+     */
+    explicit bigint_memo(size_t bytes = size_t(64) << 20) : limit(bytes) {}
+
+    bigint_memo(const bigint_memo &) = delete;
+    bigint_memo &operator=(const bigint_memo &) = delete;
+
+private:
+    /**
+     * @brief The functions whose results are cached.
+     *
+     */
+    enum class kind
+    {
+        factorial,
+        binomial,
+        power
+    };
+
+    /**
+     * @brief The function and the arguments of a result.
+     *
+     * Keys are ordered by function, base, then the other arguments, so the
+     * cached factorials, and the cached powers of a base, are consecutive and
+     * sorted by their argument.
+     *
+     */
+    struct key
+    {
+        kind function;
+        bigint base;
+        uint64_t n;
+        uint64_t k;
+
+        bool operator<(const key &rhs) const
+        {
+            if (function != rhs.function)
+                return function < rhs.function;
+            if (base != rhs.base)
+                return base < rhs.base;
+            return std::tie(n, k) < std::tie(rhs.n, rhs.k);
+        }
+    };
+
+    /**
+     * @brief A cached result, with its size and its place in the recency order.
+     *
+     */
+    struct entry
+    {
+        bigint value;
+        size_t bytes;
+        std::list<const key *>::iterator position;
+    };
+
+    /**
+     * @brief The cached results.
+     *
+     */
+    std::map<key, entry> entries;
+
+    /**
+     * @brief The keys of the cached results, most recently used first.
+     *
+     */
+    std::list<const key *> order;
+
+    /**
+     * @brief The bytes used by the cached results, and the capacity.
+     *
+     */
+    size_t used = 0;
+    size_t limit;
+
+    /**
+     * @brief The lookup counts.
+     *
+     */
+    statistics counts;
+
+    /**
+     * @brief Guards all of the above.
+     *
+     */
+    mutable std::mutex lock;
+
+    /**
+     * @brief Returns a cached result, or computes and caches it.
+     *
+     * For factorials and powers, the compute function gets the key and the value
+     * of the largest cached result of the same function (and base) below the
+     * one asked for, or null pointers when there is none.
+     *
+     * @param k The key of the result
+     * @param compute The function computing the result
+     * @return bigint The result
+     */
+    template <typename Compute>
+    bigint memoize(const key &k, Compute compute)
+    {
+        key below_key = k;
+        bigint below_value(0);
+        bool reuse = false;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            auto it = entries.lower_bound(k);
+            if (it != entries.end() && !(k < it->first))
+            {
+                ++counts.hits;
+                touch(it->second);
+                return it->second.value;
+            }
+            ++counts.misses;
+            if (k.function != kind::binomial && it != entries.begin())
+            {
+                --it;
+                if (it->first.function == k.function && it->first.base == k.base)
+                {
+                    ++counts.reuses;
+                    touch(it->second);
+                    below_key = it->first;
+                    below_value = it->second.value;
+                    reuse = true;
+                }
+            }
+        }
+
+        bigint result = reuse ? compute(&below_key, &below_value) : compute(nullptr, nullptr);
+
+        std::lock_guard<std::mutex> guard(lock);
+        size_t bytes = result.memory_usage();
+        if (bytes <= limit && entries.find(k) == entries.end())
+        {
+            auto it = entries.emplace(k, entry{result, bytes, order.end()}).first;
+            it->second.position = order.insert(order.begin(), &it->first);
+            used += bytes;
+            evict();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Moves a result to the front of the recency order.
+     *
+     * @param e The result
+     */
+    void touch(entry &e)
+    {
+        order.splice(order.begin(), order, e.position);
+    }
+
+    /**
+     * @brief Evicts the least recently used results until the rest fit the capacity.
+     *
+     */
+    void evict()
+    {
+        while (used > limit)
+        {
+            auto it = entries.find(*order.back());
+            used -= it->second.bytes;
+            order.pop_back();
+            entries.erase(it);
+            ++counts.evictions;
+        }
+    }
+
+    /**
+     * @brief Packs the integers from lo to hi into words, each the product of a run of them.
+     *
+     * @param lo The first integer
+     * @param hi The last integer, below lo for an empty product
+     * @return std::vector<uint64_t> The words
+     */
+    static std::vector<uint64_t> range_words(uint64_t lo, uint64_t hi)
+    {
+        if (hi > static_cast<uint64_t>(INT64_MAX))
+            throw std::invalid_argument("Factor must fit a signed 64-bit integer.");
+
+        std::vector<uint64_t> words;
+        uint64_t word = 1;
+        for (uint64_t i = lo; i <= hi; ++i)
+            pack(words, word, i);
+        words.push_back(word);
+        return words;
+    }
+
+    /**
+     * @brief Packs the factors of C(n, k) into words.
+     *
+     * C(n, k) is the product of the k integers n - k + 1, ..., n divided by k!.
+     * For every prime p <= k, its exponent in k! is found by Legendre's formula
+     * and that many factors p are divided out of the integers that are
+     * multiples of p, which the product always has enough of. Only the primes
+     * up to k are sieved, and no bigint division is needed.
+     *
+     * @param n The size of the set
+     * @param k The size of the subsets, at most n / 2
+     * @return std::vector<uint64_t> The words
+     */
+    static std::vector<uint64_t> binomial_words(uint64_t n, uint64_t k)
+    {
+        if (k >= std::vector<uint64_t>().max_size())
+            throw std::invalid_argument("Binomial coefficient is too large.");
+
+        uint64_t low = n - k + 1;
+        std::vector<uint64_t> terms(static_cast<size_t>(k));
+        for (size_t i = 0; i < terms.size(); ++i)
+            terms[i] = low + i;
+
+        std::vector<bool> composite(terms.size() + 1, false);
+        for (uint64_t p = 2; p <= k; ++p)
+        {
+            if (composite[static_cast<size_t>(p)])
+                continue;
+            if (p <= k / p)
+                for (uint64_t m = p * p; m <= k; m += p)
+                    composite[static_cast<size_t>(m)] = true;
+
+            uint64_t exponent = 0;
+            for (uint64_t q = p;; q *= p)
+            {
+                exponent += k / q;
+                if (q > k / p)
+                    break;
+            }
+
+            // Dividing a term by p doesn't change whether it is a multiple of another prime
+            for (uint64_t i = (p - low % p) % p; i < k && exponent > 0; i += p)
+                while (exponent > 0 && terms[static_cast<size_t>(i)] % p == 0)
+                {
+                    terms[static_cast<size_t>(i)] /= p;
+                    --exponent;
+                }
+        }
+
+        std::vector<uint64_t> words;
+        uint64_t word = 1;
+        for (uint64_t term : terms)
+            pack(words, word, term);
+        words.push_back(word);
+        return words;
+    }
+
+    /**
+     * @brief Multiplies a factor into the word being filled, starting a new one when it would overflow.
+     *
+     * @param words The full words
+     * @param word The word being filled
+     * @param factor The factor, at least 1
+     */
+    static void pack(std::vector<uint64_t> &words, uint64_t &word, uint64_t factor)
+    {
+        if (factor > UINT64_MAX / word)
+        {
+            words.push_back(word);
+            word = 1;
+        }
+        word *= factor;
+    }
+
+    /**
+     * @brief Multiplies words as a balanced tree, so the operands of each multiplication have similar sizes.
+     *
+     * @param words The factors
+     * @return bigint The product
+     */
+    static bigint product(const std::vector<uint64_t> &words)
+    {
+        std::vector<bigint> level;
+        level.reserve(words.size());
+        for (uint64_t word : words)
+        {
+            // bigint is built from int64_t, so a word above INT64_MAX is built from its halves
+            if (word <= static_cast<uint64_t>(INT64_MAX))
+                level.emplace_back(static_cast<int64_t>(word));
+            else
+                level.push_back(bigint(static_cast<int64_t>(word / 2)) * bigint(2) + bigint(static_cast<int64_t>(word % 2)));
+        }
+        while (level.size() > 1)
+        {
+            std::vector<bigint> next;
+            next.reserve((level.size() + 1) / 2);
+            for (size_t i = 0; i + 1 < level.size(); i += 2)
+                next.push_back(level[i] * level[i + 1]);
+            if (level.size() % 2 == 1)
+                next.push_back(std::move(level.back()));
+            level = std::move(next);
+        }
+        return level.empty() ? bigint(1) : std::move(level[0]);
+    }
+
+    /**
+     * @brief Computes a power by repeated squaring.
+     *
+     * @param base The base
+     * @param exponent The exponent
+     * @return bigint base^exponent
+     */
+    static bigint power(const bigint &base, uint64_t exponent)
+    {
+        bigint result(1);
+        bigint square = base;
+        while (exponent > 0)
+        {
+            if (exponent & 1)
+                result *= square;
+            exponent >>= 1;
+            if (exponent > 0)
+                square *= square;
+        }
+        return result;
+    }
+};
+
+#endif // BIGINT_MEMO_HPP
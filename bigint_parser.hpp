@@ -0,0 +1,331 @@
+/**
+ * @file bigint_parser.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_parser
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_PARSER_HPP
+#define BIGINT_PARSER_HPP
+
+#include "bigint.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief An incremental parser building a bigint from text that arrives in chunks
+ *
+ * The text has the form accepted by the bigint string constructors: an
+ * optional '-' followed by digits of the base. It can be split anywhere,
+ * across any number of feed() calls, and every chunk is validated and
+ * consumed as it arrives, so the whole text never has to be held.
+ *
+ * Decimal digits are stored as they are, so they are kept one byte each until
+ * finish(). In other bases the digits are packed into blocks that fit a 64-bit
+ * integer, and the blocks are combined eagerly into partial results like a
+ * binary counter: two results covering 2^j blocks each are merged into one
+ * covering 2^(j+1), by multiplying the older one by a power of the base. This
+ * builds the same balanced product tree as a divide-and-conquer conversion,
+ * so the cost is that of a few large multiplications rather than one
+ * multiplication by the base per digit, as in bigint(const std::string &, int).
+ *
+ */
+class bigint_parser
+{
+public:
+    /**
+     * @brief Construct a new bigint_parser object for a base.
+     *
+     * @param base The base of the digits (must be between 2 and 36)
+     */
+    explicit bigint_parser(int base = 10) : base(base)
+    {
+        if (base < 2 || base > 36)
+            throw std::invalid_argument("Base must be between 2 and 36.");
+
+        // The largest power of the base that a block holds without overflowing int64_t
+        block_power = static_cast<uint64_t>(base);
+        block_digits = 1;
+        while (block_power <= static_cast<uint64_t>(INT64_MAX) / static_cast<uint64_t>(base))
+        {
+            block_power *= static_cast<uint64_t>(base);
+            ++block_digits;
+        }
+    }
+
+    /**
+     * @brief Consumes the next chunk of the text.
+     *
+     * @param data The characters of the chunk
+     * @param size The number of characters
+     * @return bigint_parser& A reference to the current object, for chaining
+     */
+    bigint_parser &feed(const char *data, size_t size)
+    {
+        size_t i = 0;
+        if (size > 0 && !started)
+        {
+            started = true;
+            if (data[0] == '-')
+            {
+                negative = true;
+                if (base == 10)
+                    decimal.push_back('-');
+                ++i;
+            }
+        }
+
+        if (base == 10)
+        {
+            // Validate the chunk in one pass and append it at once, without its leading zeros
+            for (size_t k = i; k < size; ++k)
+                if (static_cast<unsigned char>(data[k] - '0') > 9)
+                    throw std::invalid_argument("Invalid character in string!");
+            count += size - i;
+            if (decimal.size() == (negative ? 1u : 0u))
+                while (i < size && data[i] == '0')
+                    ++i;
+            decimal.append(data + i, size - i);
+            return *this;
+        }
+
+        for (; i < size; ++i)
+        {
+            block = block * static_cast<uint64_t>(base) + static_cast<uint64_t>(digit_value(data[i]));
+            ++count;
+            if (++block_used == block_digits)
+            {
+                push_block();
+                block = 0;
+                block_used = 0;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Consumes the next chunk of the text.
+     *
+     * @param chunk The characters of the chunk
+     * @return bigint_parser& A reference to the current object, for chaining
+     */
+    bigint_parser &feed(const std::string &chunk)
+    {
+        return feed(chunk.data(), chunk.size());
+    }
+
+    /**
+     * @brief Consumes a stream until its end, a chunk at a time.
+     *
+     * @param in The stream
+     * @param chunk The number of characters read at a time
+     * @return bigint_parser& A reference to the current object, for chaining
+     */
+    bigint_parser &read(std::istream &in, size_t chunk = 65536)
+    {
+        std::vector<char> buffer(chunk == 0 ? 1 : chunk);
+        while (in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || in.gcount() > 0)
+            feed(buffer.data(), static_cast<size_t>(in.gcount()));
+        return *this;
+    }
+
+    /**
+     * @brief Returns the number of digits consumed so far.
+     *
+     * @return size_t The number of digits, leading zeros included
+     */
+    size_t digits() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief Returns the value of the text consumed and resets the parser for a new text.
+     *
+     * @return bigint The value
+     */
+    bigint finish()
+    {
+        if (count == 0)
+        {
+            reset();
+            throw std::invalid_argument("String cannot be empty!");
+        }
+
+        bigint result(0);
+        if (base == 10)
+        {
+            if (decimal.size() == (negative ? 1u : 0u))
+                decimal.push_back('0');
+            result = bigint(decimal);
+        }
+        else
+        {
+            // Fold the partial results from the oldest, shifting each one past the next
+            for (size_t i = 0; i < stack.size(); ++i)
+            {
+                if (i > 0)
+                    result *= level_power(stack[i].level);
+                result += stack[i].value;
+            }
+            if (block_used > 0)
+            {
+                uint64_t power = 1;
+                for (size_t i = 0; i < block_used; ++i)
+                    power *= static_cast<uint64_t>(base);
+                result *= bigint(static_cast<int64_t>(power));
+                result += bigint(static_cast<int64_t>(block));
+            }
+            if (negative)
+                result = -result;
+        }
+        reset();
+        return result;
+    }
+
+    /**
+     * @brief Discards the text consumed so far.
+     *
+     */
+    void reset()
+    {
+        started = false;
+        negative = false;
+        count = 0;
+        decimal.clear();
+        decimal.shrink_to_fit();
+        stack.clear();
+        block = 0;
+        block_used = 0;
+    }
+
+private:
+    /**
+     * @brief A partial result, the value of 2^level consecutive blocks.
+     *
+     */
+    struct partial
+    {
+        bigint value;
+        size_t level;
+    };
+
+    /**
+     * @brief The base of the digits.
+     *
+     */
+    int base;
+
+    /**
+     * @brief The number of digits per block, and the base raised to it.
+     *
+     */
+    size_t block_digits;
+    uint64_t block_power;
+
+    /**
+     * @brief Whether a character has been consumed, after which '-' is invalid.
+     *
+     */
+    bool started = false;
+
+    /**
+     * @brief Whether the text starts with '-'.
+     *
+     */
+    bool negative = false;
+
+    /**
+     * @brief The number of digits consumed.
+     *
+     */
+    size_t count = 0;
+
+    /**
+     * @brief The sign and the decimal digits from the first non-zero one, as text (base 10 only).
+     *
+     */
+    std::string decimal;
+
+    /**
+     * @brief The partial results, oldest first, with strictly decreasing levels.
+     *
+     */
+    std::vector<partial> stack;
+
+    /**
+     * @brief The block being filled, and the number of digits in it.
+     *
+     */
+    uint64_t block = 0;
+    size_t block_used = 0;
+
+    /**
+     * @brief powers[j] holds block_power^(2^j), the factor between results of level j.
+     *
+     */
+    std::vector<bigint> powers;
+
+    /**
+     * @brief Returns the value of a digit character in the base, for bases other than 10.
+     *
+     * @param c The character
+     * @return int The value
+     */
+    int digit_value(char c) const
+    {
+        int value = 36;
+        if ('0' <= c && c <= '9')
+            value = c - '0';
+        else if ('A' <= c && c <= 'Z')
+            value = c - 'A' + 10;
+        else if ('a' <= c && c <= 'z')
+            value = c - 'a' + 10;
+        if (value >= base)
+            throw std::invalid_argument("Invalid character in string for the given base.");
+        return value;
+    }
+
+    /**
+     * @brief Returns the power of the base spanned by a partial result of a level.
+     *
+     * @param level The level
+     * @return const bigint& block_power^(2^level)
+     */
+    const bigint &level_power(size_t level)
+    {
+        if (powers.empty())
+            powers.push_back(bigint(static_cast<int64_t>(block_power)));
+        while (powers.size() <= level)
+            powers.push_back(powers.back() * powers.back());
+        return powers[level];
+    }
+
+    /**
+     * @brief Adds a full block as a result of level 0, merging results of equal level.
+     *
+     */
+    void push_block()
+    {
+        stack.push_back({bigint(static_cast<int64_t>(block)), 0});
+        while (stack.size() >= 2 && stack[stack.size() - 2].level == stack.back().level)
+        {
+            partial low = std::move(stack.back());
+            stack.pop_back();
+            partial &high = stack.back();
+            high.value *= level_power(low.level);
+            high.value += low.value;
+            ++high.level;
+        }
+    }
+};
+
+#endif // BIGINT_PARSER_HPP
@@ -0,0 +1,534 @@
+/**
+ * @file bigint_poly.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_poly
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_POLY_HPP
+#define BIGINT_POLY_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A class for polynomials with bigint coefficients
+ *
+ * The coefficients are stored from the constant term upwards, without zero
+ * leading coefficients, so the zero polynomial has no coefficients.
+ *
+ */
+class bigint_poly
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * @param out an instance of std::ostream
+     * @param poly the bigint_poly object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const bigint_poly &poly)
+    {
+        return out << poly.to_string();
+    }
+
+public:
+    /**
+     * @brief Checks if two polynomials are equal
+     *
+     * @param rhs The polynomial to compare with
+     * @return true if both polynomials are equal
+     * @return false otherwise
+     */
+    bool operator==(const bigint_poly &rhs) const
+    {
+        return coeffs == rhs.coeffs;
+    }
+
+    /**
+     * @brief Check if two polynomials are not equal
+     *
+     * @param rhs The polynomial to compare with
+     * @return true if the polynomials are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const bigint_poly &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Adds two polynomials
+     *
+     * @param rhs The polynomial to add to the current polynomial
+     * @return bigint_poly A new one representing the sum
+     */
+    bigint_poly operator+(const bigint_poly &rhs) const
+    {
+        std::vector<bigint> sum(std::max(coeffs.size(), rhs.coeffs.size()), bigint(0));
+        for (size_t i = 0; i < coeffs.size(); ++i)
+            sum[i] = coeffs[i];
+        for (size_t i = 0; i < rhs.coeffs.size(); ++i)
+            sum[i] += rhs.coeffs[i];
+        return bigint_poly(std::move(sum));
+    }
+
+    /**
+     * @brief Subtracts the given polynomial from the current polynomial
+     *
+     * @param rhs The polynomial to subtract
+     * @return bigint_poly A new one representing the difference
+     */
+    bigint_poly operator-(const bigint_poly &rhs) const
+    {
+        return *this + -rhs;
+    }
+
+    /**
+     * @brief Multiplies two polynomials
+     *
+     * Uses Kronecker substitution when the shorter factor has at least
+     * kronecker_threshold terms, and the schoolbook product otherwise.
+     *
+     * @param rhs The polynomial to multiply with the current polynomial
+     * @return bigint_poly A new one representing the product
+     */
+    bigint_poly operator*(const bigint_poly &rhs) const
+    {
+        if (coeffs.empty() || rhs.coeffs.empty())
+            return bigint_poly();
+        if (std::min(coeffs.size(), rhs.coeffs.size()) >= kronecker_threshold)
+            return multiply_kronecker(*this, rhs);
+        return multiply_schoolbook(*this, rhs);
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return bigint_poly& A reference to the current object after the operation
+     */
+    bigint_poly &operator+=(const bigint_poly &rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return bigint_poly& A reference to the current object after the operation
+     */
+    bigint_poly &operator-=(const bigint_poly &rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return bigint_poly& A reference to the current object after the operation
+     */
+    bigint_poly &operator*=(const bigint_poly &rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return bigint_poly A negated polynomial
+     */
+    bigint_poly operator-() const
+    {
+        std::vector<bigint> negated(coeffs);
+        for (bigint &c : negated)
+            c = -c;
+        return bigint_poly(std::move(negated));
+    }
+
+    /**
+     * @brief Multiplies two polynomials term by term.
+     *
+     * @param a The first polynomial
+     * @param b The second polynomial
+     * @return bigint_poly The product
+     */
+    static bigint_poly multiply_schoolbook(const bigint_poly &a, const bigint_poly &b)
+    {
+        if (a.coeffs.empty() || b.coeffs.empty())
+            return bigint_poly();
+        std::vector<bigint> product(a.coeffs.size() + b.coeffs.size() - 1, bigint(0));
+        for (size_t i = 0; i < a.coeffs.size(); ++i)
+            for (size_t j = 0; j < b.coeffs.size(); ++j)
+                product[i + j] += a.coeffs[i] * b.coeffs[j];
+        return bigint_poly(std::move(product));
+    }
+
+    /**
+     * @brief Multiplies two polynomials by Kronecker substitution.
+     *
+     * Both polynomials are evaluated at x = 10^w, with w large enough that every
+     * coefficient of the product fits in a slot of w digits with room for its sign.
+     * Since bigint stores decimal digits, packing writes each coefficient into its
+     * slot and unpacking reads the slots back; the single bigint product does all
+     * the work.
+     *
+     * @param a The first polynomial
+     * @param b The second polynomial
+     * @return bigint_poly The product
+     */
+    static bigint_poly multiply_kronecker(const bigint_poly &a, const bigint_poly &b)
+    {
+        if (a.coeffs.empty() || b.coeffs.empty())
+            return bigint_poly();
+
+        // |c_k| <= min(len) * max|a_i| * max|b_j| < 10^(w - 1), below the balanced half 5 * 10^(w - 1)
+        size_t terms = std::min(a.coeffs.size(), b.coeffs.size());
+        size_t width = a.max_digits() + b.max_digits() + std::to_string(terms).size() + 1;
+        bigint product = pack(a.coeffs, width) * pack(b.coeffs, width);
+        return bigint_poly(unpack(product, width, a.coeffs.size() + b.coeffs.size() - 1));
+    }
+
+    /**
+     * @brief Evaluates the polynomial at one point with Horner's rule.
+     *
+     * @param x The point
+     * @return bigint The value at x
+     */
+    bigint evaluate(const bigint &x) const
+    {
+        bigint value(0);
+        for (size_t i = coeffs.size(); i > 0; --i)
+            value = value * x + coeffs[i - 1];
+        return value;
+    }
+
+    /**
+     * @brief Evaluates the polynomial at many points with a remainder tree.
+     *
+     * The products of (x - x_j) over halves of the points form a subproduct tree;
+     * the polynomial is reduced modulo the root and the remainders are pushed down
+     * the tree, so at a leaf only the value P(x_j) is left. Below
+     * remainder_tree_threshold points, each point is evaluated with Horner's rule.
+     *
+     * @param points The points
+     * @return std::vector<bigint> The values, in the order of the points
+     */
+    std::vector<bigint> evaluate(const std::vector<bigint> &points) const
+    {
+        std::vector<bigint> values;
+        values.reserve(points.size());
+        if (points.size() < remainder_tree_threshold)
+        {
+            for (const bigint &x : points)
+                values.push_back(evaluate(x));
+            return values;
+        }
+
+        std::vector<std::vector<bigint_poly>> tree(1);
+        for (const bigint &x : points)
+            tree[0].push_back(bigint_poly({-x, bigint(1)}));
+        while (tree.back().size() > 1)
+        {
+            const std::vector<bigint_poly> &level = tree.back();
+            std::vector<bigint_poly> parents;
+            for (size_t i = 0; i + 1 < level.size(); i += 2)
+                parents.push_back(level[i] * level[i + 1]);
+            if (level.size() % 2 == 1)
+                parents.push_back(level.back());
+            tree.push_back(std::move(parents));
+        }
+
+        // The parent of node i is node i / 2 one level up, odd nodes included
+        std::vector<bigint_poly> remainders = {mod_monic(tree.back()[0])};
+        for (size_t level = tree.size() - 1; level > 0; --level)
+        {
+            std::vector<bigint_poly> children;
+            children.reserve(tree[level - 1].size());
+            for (size_t i = 0; i < tree[level - 1].size(); ++i)
+                children.push_back(remainders[i / 2].mod_monic(tree[level - 1][i]));
+            remainders = std::move(children);
+        }
+
+        for (const bigint_poly &r : remainders)
+            values.push_back(r.coefficient(0));
+        return values;
+    }
+
+    /**
+     * @brief Returns the degree of the polynomial.
+     *
+     * @return int64_t The degree, or -1 for the zero polynomial
+     */
+    int64_t degree() const
+    {
+        return static_cast<int64_t>(coeffs.size()) - 1;
+    }
+
+    /**
+     * @brief Returns the coefficient of x^i.
+     *
+     * @param i The power of x
+     * @return bigint The coefficient, 0 past the degree
+     */
+    bigint coefficient(size_t i) const
+    {
+        return i < coeffs.size() ? coeffs[i] : bigint(0);
+    }
+
+    /**
+     * @brief Returns the coefficients from the constant term upwards.
+     *
+     * @return const std::vector<bigint>& The coefficients
+     */
+    const std::vector<bigint> &coefficients() const
+    {
+        return coeffs;
+    }
+
+    /**
+     * @brief Converts the polynomial to its string representation.
+     *
+     * Terms are written from the highest power down, e.g. "3x^2 - x + 5".
+     *
+     * @return std::string The string representation, "0" for the zero polynomial
+     */
+    std::string to_string() const
+    {
+        if (coeffs.empty())
+            return "0";
+
+        std::string str;
+        for (size_t i = coeffs.size(); i > 0; --i)
+        {
+            const bigint &c = coeffs[i - 1];
+            if (c == 0)
+                continue;
+            std::string digits = (c < 0 ? -c : c).to_string(10);
+            if (str.empty())
+                str = c < 0 ? "-" : "";
+            else
+                str += c < 0 ? " - " : " + ";
+            if (digits != "1" || i == 1)
+                str += digits;
+            if (i > 1)
+                str += i == 2 ? "x" : "x^" + std::to_string(i - 1);
+        }
+        return str;
+    }
+
+    /**
+     * @brief Sets the number of terms from which multiplication uses Kronecker substitution.
+     *
+     * @param terms The new threshold, compared with the shorter factor
+     */
+    static void set_kronecker_threshold(size_t terms)
+    {
+        kronecker_threshold = terms;
+    }
+
+    /**
+     * @brief Returns the number of terms from which multiplication uses Kronecker substitution.
+     *
+     * @return size_t The threshold, compared with the shorter factor
+     */
+    static size_t get_kronecker_threshold()
+    {
+        return kronecker_threshold;
+    }
+
+    /**
+     * @brief Sets the number of points from which evaluate() uses the remainder tree.
+     *
+     * @param points The new threshold
+     */
+    static void set_remainder_tree_threshold(size_t points)
+    {
+        remainder_tree_threshold = points;
+    }
+
+    /**
+     * @brief Returns the number of points from which evaluate() uses the remainder tree.
+     *
+     * @return size_t The threshold
+     */
+    static size_t get_remainder_tree_threshold()
+    {
+        return remainder_tree_threshold;
+    }
+
+    /**
+     * @brief Construct a new bigint_poly object representing the zero polynomial.
+     *
+     */
+    bigint_poly() = default;
+
+    /**
+     * @brief Construct a new bigint_poly object from its coefficients.
+     *
+     * @param coefficients The coefficients from the constant term upwards
+     */
+    bigint_poly(std::vector<bigint> coefficients) : coeffs(std::move(coefficients))
+    {
+        trim();
+    }
+
+private:
+    /**
+     * @brief The coefficients from the constant term upwards.
+     *
+     */
+    std::vector<bigint> coeffs;
+
+    /**
+     * @brief The number of terms from which multiplication uses Kronecker substitution.
+     *
+     * The packed operands are about four times longer than the coefficients, so
+     * Kronecker substitution only pays off once Karatsuba makes the single large
+     * product cheaper than the many small ones.
+     *
+     */
+    inline static size_t kronecker_threshold = 32;
+
+    /**
+     * @brief The number of points from which evaluate() uses the remainder tree.
+     *
+     * Off by default: the remainders near the root carry coefficients as long as
+     * the values themselves, and with the multiplication available here Horner's
+     * rule stays faster at every size `bigint_tune` measures.
+     *
+     */
+    inline static size_t remainder_tree_threshold = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Removes zero leading coefficients.
+     *
+     */
+    void trim()
+    {
+        while (!coeffs.empty() && coeffs.back() == 0)
+            coeffs.pop_back();
+    }
+
+    /**
+     * @brief Returns the digit count of the largest coefficient.
+     *
+     * @return size_t The number of digits
+     */
+    size_t max_digits() const
+    {
+        size_t digits = 0;
+        for (const bigint &c : coeffs)
+            digits = std::max(digits, c.digits());
+        return digits;
+    }
+
+    /**
+     * @brief Reduces the polynomial modulo a monic polynomial.
+     *
+     * @param divisor The monic divisor
+     * @return bigint_poly The remainder, of lower degree than the divisor
+     */
+    bigint_poly mod_monic(const bigint_poly &divisor) const
+    {
+        if (coeffs.size() < divisor.coeffs.size())
+            return *this;
+
+        std::vector<bigint> rem(coeffs);
+        size_t d = divisor.coeffs.size() - 1;
+        for (size_t i = rem.size(); i > d; --i)
+        {
+            bigint q = rem[i - 1];
+            if (q == 0)
+                continue;
+            for (size_t j = 0; j < d; ++j)
+                rem[i - 1 - d + j] -= q * divisor.coeffs[j];
+        }
+        rem.resize(d);
+        return bigint_poly(std::move(rem));
+    }
+
+    /**
+     * @brief Evaluates coefficients at x = 10^width.
+     *
+     * The digits of the positive and the negative coefficients are written into two
+     * digit vectors, which are subtracted once.
+     *
+     * @param coefficients The coefficients, each below 10^width in absolute value
+     * @param width The slot width in digits
+     * @return bigint The packed value
+     */
+    static bigint pack(const std::vector<bigint> &coefficients, size_t width)
+    {
+        size_t length = coefficients.size() * width;
+        std::vector<uint8_t> positive(length, 0);
+        std::vector<uint8_t> negative;
+        for (size_t i = 0; i < coefficients.size(); ++i)
+        {
+            const bigint &c = coefficients[i];
+            if (c.is_negative && negative.empty())
+                negative.assign(length, 0);
+            std::vector<uint8_t> &slots = c.is_negative ? negative : positive;
+            std::copy(c.vec.begin(), c.vec.end(), slots.begin() + static_cast<std::ptrdiff_t>(i * width));
+        }
+        bigint value(false, std::move(positive));
+        if (!negative.empty())
+            value -= bigint(false, std::move(negative));
+        return value;
+    }
+
+    /**
+     * @brief Splits a packed value back into coefficients.
+     *
+     * Each slot is read as a balanced digit in (-10^width / 2, 10^width / 2], with a
+     * borrow into the next slot for the negative ones.
+     *
+     * @param value The packed value
+     * @param width The slot width in digits
+     * @param count The number of coefficients
+     * @return std::vector<bigint> The coefficients from the constant term upwards
+     */
+    static std::vector<bigint> unpack(const bigint &value, size_t width, size_t count)
+    {
+        const bigint half = bigint(5).shift10(static_cast<int64_t>(width) - 1);
+        const bigint base = bigint(1).shift10(static_cast<int64_t>(width));
+        bool negative = value < 0;
+
+        std::vector<bigint> coefficients;
+        coefficients.reserve(count);
+        bool carry = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Slots past the most significant digit of the value are zero
+            size_t first = std::min(i * width, value.vec.size());
+            size_t last = std::min(first + width, value.vec.size());
+            bigint c = first == last ? bigint(0)
+                                     : bigint(false, std::vector<uint8_t>(value.vec.begin() + static_cast<std::ptrdiff_t>(first),
+                                                                          value.vec.begin() + static_cast<std::ptrdiff_t>(last)));
+            if (carry)
+                ++c;
+            carry = c > half;
+            if (carry)
+                c -= base;
+            coefficients.push_back(negative ? -c : c);
+        }
+        return coefficients;
+    }
+};
+
+#endif // BIGINT_POLY_HPP
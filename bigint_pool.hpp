@@ -0,0 +1,467 @@
+/**
+ * @file bigint_pool.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_pool
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_POOL_HPP
+#define BIGINT_POOL_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief A thread-safe pool of interned, immutable bigint values
+ *
+ * Interning a value returns a handle to the one node holding that value in the
+ * pool, creating it only the first time. Equal values therefore share their
+ * digits, and two handles of the same pool are equal exactly when they point to
+ * the same node, which is a pointer comparison.
+ *
+ * The table is split into shards selected by the hash of the value, each with
+ * its own mutex, so threads interning different values rarely contend. Handles
+ * count references to their node; nodes nobody refers to any more are freed by
+ * collect(), and by a sweep of the shard whenever it has doubled in size since
+ * the last one. Handles must not outlive their pool.
+ *
+ */
+class bigint_pool
+{
+    /**
+     * @brief A node holding one interned value.
+     *
+     */
+    struct node
+    {
+        node(bigint v, size_t h) : value(std::move(v)), hash(h) {}
+
+        const bigint value;
+        const size_t hash;
+        std::atomic<size_t> refs{0};
+    };
+
+public:
+    /**
+     * @brief A reference counted handle to an interned value
+     *
+     * A default-constructed handle is empty. Copies share the node and moves
+     * transfer it.
+     *
+     */
+    class handle
+    {
+        /**
+         * @brief I/O operator for insertion overloading
+         *
+         * @param out an instance of std::ostream
+         * @param h the handle whose value will be output
+         * @return std::ostream& A reference to the same output stream that's passed as an argument
+         */
+        friend std::ostream &operator<<(std::ostream &out, const handle &h)
+        {
+            return out << *h;
+        }
+
+    public:
+        /**
+         * @brief Checks if two handles refer to the same node, i.e. the same value of the same pool
+         *
+         * @param rhs The handle to compare with
+         * @return true if both handles refer to the same node
+         * @return false otherwise
+         */
+        bool operator==(const handle &rhs) const
+        {
+            return ptr == rhs.ptr;
+        }
+
+        /**
+         * @brief Checks if two handles refer to different nodes
+         *
+         * @param rhs The handle to compare with
+         * @return true if the handles refer to different nodes
+         * @return false otherwise
+         */
+        bool operator!=(const handle &rhs) const
+        {
+            return ptr != rhs.ptr;
+        }
+
+        /**
+         * @brief Returns the interned value.
+         *
+         * @return const bigint& The value, valid while a handle to it exists
+         */
+        const bigint &operator*() const
+        {
+            return ptr->value;
+        }
+
+        /**
+         * @brief Accesses the members of the interned value.
+         *
+         * @return const bigint* The value, valid while a handle to it exists
+         */
+        const bigint *operator->() const
+        {
+            return &ptr->value;
+        }
+
+        /**
+         * @brief Checks if the handle refers to a value.
+         *
+         * @return true if the handle isn't empty
+         * @return false otherwise
+         */
+        explicit operator bool() const
+        {
+            return ptr != nullptr;
+        }
+
+        /**
+         * @brief Returns the hash of the interned value, computed once when it was interned.
+         *
+         * @return size_t The hash, equal to bigint::hash() of the value
+         */
+        size_t hash() const
+        {
+            return ptr->hash;
+        }
+
+        /**
+         * @brief Returns the number of handles referring to the same node.
+         *
+         * @return size_t The number of handles, 0 for an empty handle
+         */
+        size_t use_count() const
+        {
+            return ptr ? ptr->refs.load(std::memory_order_relaxed) : 0;
+        }
+
+        /**
+         * @brief Construct a new empty handle object.
+         *
+         */
+        handle() = default;
+
+        /**
+         * @brief Construct a new handle object sharing the node of another.
+         *
+         * @param other The handle to copy
+         */
+        handle(const handle &other) : ptr(other.ptr)
+        {
+            if (ptr)
+                ptr->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Construct a new handle object taking the node of another, which becomes empty.
+         *
+         * @param other The handle to move from
+         */
+        handle(handle &&other) noexcept : ptr(other.ptr)
+        {
+            other.ptr = nullptr;
+        }
+
+        /**
+         * @brief Makes the handle share the node of another.
+         *
+         * @param other The handle to copy
+         * @return handle& A reference to the current object after the operation
+         */
+        handle &operator=(const handle &other)
+        {
+            handle copy(other);
+            std::swap(ptr, copy.ptr);
+            return *this;
+        }
+
+        /**
+         * @brief Makes the handle take the node of another, which becomes empty.
+         *
+         * @param other The handle to move from
+         * @return handle& A reference to the current object after the operation
+         */
+        handle &operator=(handle &&other) noexcept
+        {
+            std::swap(ptr, other.ptr);
+            return *this;
+        }
+
+        /**
+         * @brief Destroy the handle object, dropping its reference.
+         *
+         */
+        ~handle()
+        {
+            if (ptr)
+                ptr->refs.fetch_sub(1, std::memory_order_release);
+        }
+
+    private:
+        friend class bigint_pool;
+
+        /**
+         * @brief Construct a new handle object for a node, taking a reference already counted.
+         *
+         * @param n The node
+         */
+        explicit handle(node *n) : ptr(n) {}
+
+        /**
+         * @brief The node, or nullptr for an empty handle.
+         *
+         */
+        node *ptr = nullptr;
+    };
+
+    /**
+     * @brief Interns a value.
+     *
+     * @param value The value
+     * @return handle The handle to the pool's node holding the value
+     */
+    handle intern(const bigint &value)
+    {
+        size_t h = value.hash();
+        return find_or_insert(
+            h, [&](const bigint &candidate)
+            { return candidate == value; },
+            [&]
+            { return value; });
+    }
+
+    /**
+     * @brief Interns a value, moving it into the pool if it's new.
+     *
+     * @param value The value
+     * @return handle The handle to the pool's node holding the value
+     */
+    handle intern(bigint &&value)
+    {
+        size_t h = value.hash();
+        return find_or_insert(
+            h, [&](const bigint &candidate)
+            { return candidate == value; },
+            [&]
+            { return std::move(value); });
+    }
+
+    /**
+     * @brief Interns a signed 64-bit integer, constructing a bigint only if it's new.
+     *
+     * @param num The signed 64-bit integer
+     * @return handle The handle to the pool's node holding the value
+     */
+    handle intern(int64_t num)
+    {
+        return find_or_insert(
+            bigint::hash(num), [&](const bigint &candidate)
+            { return candidate.equals(num); },
+            [&]
+            { return bigint(num); });
+    }
+
+    /**
+     * @brief Interns the value of a decimal string.
+     *
+     * Spellings of the same value, e.g. "007" and "7", give the same handle.
+     *
+     * @param str The decimal string, as accepted by bigint(const std::string &)
+     * @return handle The handle to the pool's node holding the value
+     */
+    handle intern(const std::string &str)
+    {
+        return intern(bigint(str));
+    }
+
+    /**
+     * @brief Frees the nodes no handle refers to any more.
+     *
+     * @return size_t The number of nodes freed
+     */
+    size_t collect()
+    {
+        size_t freed = 0;
+        for (shard &s : shards)
+        {
+            std::lock_guard<std::mutex> guard(s.lock);
+            freed += sweep(s);
+        }
+        return freed;
+    }
+
+    /**
+     * @brief Returns the number of nodes in the pool, including unreferenced ones not yet collected.
+     *
+     * @return size_t The number of nodes
+     */
+    size_t size() const
+    {
+        size_t count = 0;
+        for (const shard &s : shards)
+        {
+            std::lock_guard<std::mutex> guard(s.lock);
+            count += s.nodes.size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Returns a process-wide pool.
+     *
+     * @return bigint_pool& The pool, alive until the program exits
+     */
+    static bigint_pool &global()
+    {
+        static bigint_pool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Construct a new empty bigint_pool object.
+     *
+     */
+    bigint_pool() = default;
+
+    bigint_pool(const bigint_pool &) = delete;
+    bigint_pool &operator=(const bigint_pool &) = delete;
+
+    /**
+     * @brief Destroy the bigint_pool object and every node.
+     *
+     */
+    ~bigint_pool()
+    {
+        for (shard &s : shards)
+            for (auto &entry : s.nodes)
+                delete entry.second;
+    }
+
+private:
+    /**
+     * @brief The number of shards, a power of two.
+     *
+     */
+    static constexpr size_t shard_count = 64;
+
+    /**
+     * @brief One part of the table, with its own lock.
+     *
+     * Aligned to a cache line so that the locks of neighbouring shards don't
+     * share one.
+     *
+     */
+    struct alignas(64) shard
+    {
+        mutable std::mutex lock;
+        std::unordered_multimap<size_t, node *> nodes;
+        size_t sweep_at = 64;
+    };
+
+    /**
+     * @brief The shards.
+     *
+     */
+    shard shards[shard_count];
+
+    /**
+     * @brief Returns the handle to the node matching a value, inserting one if there's none.
+     *
+     * The reference of the returned handle is counted under the shard lock, so
+     * a node found here can't be freed by a concurrent sweep.
+     *
+     * @param h The hash of the value
+     * @param matches Tells whether a stored value is the value
+     * @param make Produces the value to store
+     * @return handle The handle to the node
+     */
+    template <typename Matches, typename Make>
+    handle find_or_insert(size_t h, Matches matches, Make make)
+    {
+        // The low bits pick the bucket within the shard, so the shard comes from the top
+        // six bits, wherever they are for the width of size_t
+        shard &s = shards[(h >> (std::numeric_limits<size_t>::digits - 6)) % shard_count];
+        std::lock_guard<std::mutex> guard(s.lock);
+
+        auto range = s.nodes.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it)
+            if (matches(it->second->value))
+            {
+                it->second->refs.fetch_add(1, std::memory_order_relaxed);
+                return handle(it->second);
+            }
+
+        if (s.nodes.size() >= s.sweep_at)
+        {
+            sweep(s);
+            s.sweep_at = std::max<size_t>(64, 2 * s.nodes.size());
+        }
+        // The table owns the node only once emplace succeeds
+        std::unique_ptr<node> n(new node(make(), h));
+        n->refs.store(1, std::memory_order_relaxed);
+        s.nodes.emplace(h, n.get());
+        return handle(n.release());
+    }
+
+    /**
+     * @brief Frees the unreferenced nodes of a shard, whose lock is held.
+     *
+     * A node whose count is zero can only gain a reference through
+     * find_or_insert, which needs the same lock.
+     *
+     * @param s The shard
+     * @return size_t The number of nodes freed
+     */
+    static size_t sweep(shard &s)
+    {
+        size_t freed = 0;
+        for (auto it = s.nodes.begin(); it != s.nodes.end();)
+        {
+            if (it->second->refs.load(std::memory_order_acquire) == 0)
+            {
+                delete it->second;
+                it = s.nodes.erase(it);
+                ++freed;
+            }
+            else
+                ++it;
+        }
+        return freed;
+    }
+};
+
+namespace std
+{
+    /**
+     * @brief Hashes pool handles by their cached value hash.
+     *
+     */
+    template <>
+    struct hash<bigint_pool::handle>
+    {
+        size_t operator()(const bigint_pool::handle &h) const
+        {
+            return h ? h.hash() : 0;
+        }
+    };
+}
+
+#endif // BIGINT_POOL_HPP
@@ -0,0 +1,209 @@
+/**
+ * @file bigint_scan.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_scan
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_SCAN_HPP
+#define BIGINT_SCAN_HPP
+
+#include "bigint.hpp"
+#include "bigint_accumulator.hpp"
+#include "bigint_threads.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Prefix sums of bigint ranges
+ *
+ * The running total is updated with operator+=, which adds into its own
+ * digit vector, and each prefix sum is copy-assigned to the output, which
+ * reuses the output's digit vector when it is large enough. Scanning into a
+ * range of bigint values that already hold sums of a similar size, e.g. when
+ * the same report is recomputed, then allocates almost nothing.
+ *
+ * The parallel scans split the range into one block per thread of
+ * bigint_threads and make two passes: the first sums every block with a
+ * bigint_accumulator, the offset of each block is the sum of the blocks
+ * before it, and the second scans every block from its offset. All scans may
+ * write over their input. An exception in a block, e.g. std::bad_alloc, is
+ * rethrown to the caller after every thread has stopped.
+ *
+ */
+class bigint_scan
+{
+public:
+    /**
+     * @brief Writes the inclusive prefix sums of a range, out[i] = first[0] + ... + first[i].
+     *
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @param out The beginning of the output, which may be first
+     * @return OutputIt The end of the output
+     */
+    template <typename InputIt, typename OutputIt>
+    static OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt out)
+    {
+        bigint running(0);
+        for (; first != last; ++first, ++out)
+        {
+            running += *first;
+            *out = running;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Writes the exclusive prefix sums of a range, out[i] = init + first[0] + ... + first[i - 1].
+     *
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @param out The beginning of the output, which may be first
+     * @param init The first prefix sum
+     * @return OutputIt The end of the output
+     */
+    template <typename InputIt, typename OutputIt>
+    static OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt out, const bigint &init = bigint(0))
+    {
+        bigint running = init;
+        bigint value(0);
+        for (; first != last; ++first, ++out)
+        {
+            // Read the element before its output overwrites it
+            value = *first;
+            *out = running;
+            running += value;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Writes the inclusive prefix sums of a range, on bigint_threads::get_thread_count() threads.
+     *
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @param out The beginning of the output, which may be first
+     * @return RandomIt2 The end of the output
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    static RandomIt2 parallel_inclusive_scan(RandomIt1 first, RandomIt1 last, RandomIt2 out)
+    {
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        size_t blocks = block_count(count);
+        if (blocks <= 1)
+            return inclusive_scan(first, last, out);
+
+        std::vector<bigint> offsets = block_offsets(first, count, blocks, bigint(0));
+        bigint_threads::parallel_for(blocks, [&](size_t b)
+                     {
+                         size_t begin = block_begin(count, blocks, b);
+                         size_t end = block_begin(count, blocks, b + 1);
+                         bigint running = std::move(offsets[b]);
+                         for (size_t i = begin; i < end; ++i)
+                         {
+                             running += first[i];
+                             out[i] = running;
+                         } });
+        return out + static_cast<std::ptrdiff_t>(count);
+    }
+
+    /**
+     * @brief Writes the exclusive prefix sums of a range, on bigint_threads::get_thread_count() threads.
+     *
+     * @param first The beginning of the range
+     * @param last The end of the range
+     * @param out The beginning of the output, which may be first
+     * @param init The first prefix sum
+     * @return RandomIt2 The end of the output
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    static RandomIt2 parallel_exclusive_scan(RandomIt1 first, RandomIt1 last, RandomIt2 out, const bigint &init = bigint(0))
+    {
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        size_t blocks = block_count(count);
+        if (blocks <= 1)
+            return exclusive_scan(first, last, out, init);
+
+        std::vector<bigint> offsets = block_offsets(first, count, blocks, init);
+        bigint_threads::parallel_for(blocks, [&](size_t b)
+                     {
+                         size_t begin = block_begin(count, blocks, b);
+                         size_t end = block_begin(count, blocks, b + 1);
+                         bigint running = std::move(offsets[b]);
+                         bigint value(0);
+                         for (size_t i = begin; i < end; ++i)
+                         {
+                             value = first[i];
+                             out[i] = running;
+                             running += value;
+                         } });
+        return out + static_cast<std::ptrdiff_t>(count);
+    }
+
+private:
+    /**
+     * @brief The smallest number of elements worth giving a thread of its own.
+     *
+     */
+    static constexpr size_t min_block = 256;
+
+    /**
+     * @brief Returns the number of blocks a range is split into.
+     *
+     * @param count The number of elements
+     * @return size_t The number of blocks, 1 for a serial scan
+     */
+    static size_t block_count(size_t count)
+    {
+        return std::max<size_t>(std::min(bigint_threads::get_thread_count(), count / min_block), 1);
+    }
+
+    /**
+     * @brief Returns the index of the first element of a block.
+     *
+     * @param count The number of elements
+     * @param blocks The number of blocks
+     * @param b The block, or blocks for the end of the range
+     * @return size_t The index
+     */
+    static size_t block_begin(size_t count, size_t blocks, size_t b)
+    {
+        return count / blocks * b + std::min(b, count % blocks);
+    }
+
+    /**
+     * @brief Sums every block but the last in parallel and returns the sum before each block.
+     *
+     * @param first The beginning of the range
+     * @param count The number of elements
+     * @param blocks The number of blocks
+     * @param init The sum before the first block
+     * @return std::vector<bigint> The sum before each block
+     */
+    template <typename RandomIt>
+    static std::vector<bigint> block_offsets(RandomIt first, size_t count, size_t blocks, const bigint &init)
+    {
+        std::vector<bigint> offsets(blocks, bigint(0));
+        bigint_threads::parallel_for(blocks - 1, [&](size_t b)
+                     {
+                         bigint_accumulator sum;
+                         size_t end = block_begin(count, blocks, b + 1);
+                         for (size_t i = block_begin(count, blocks, b); i < end; ++i)
+                             sum += first[i];
+                         offsets[b + 1] = sum.value(); });
+
+        offsets[0] = init;
+        for (size_t b = 1; b < blocks; ++b)
+            offsets[b] += offsets[b - 1];
+        return offsets;
+    }
+};
+
+#endif // BIGINT_SCAN_HPP
@@ -0,0 +1,340 @@
+/**
+ * @file bigint_sort.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_sort
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_SORT_HPP
+#define BIGINT_SORT_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Sorting of bigint arrays and order-preserving sort keys
+ *
+ * sort() orders a range without calling operator<. The values are first
+ * keyed by sign, number of digits and leading 18 digits, held in a compact
+ * array and ordered by a radix sort on 11-bit digits, which settles most values
+ * without reading the digit vectors or comparing anything.
+ * Values whose keys tie are then sorted by a most-significant-digit radix sort
+ * on pointers, and the values themselves are only moved once at the end.
+ *
+ * key() maps a value to a byte string whose lexicographic order is the numeric
+ * order, for external sorting or for storing values in ordered key-value
+ * stores. from_key() maps it back.
+ *
+ */
+class bigint_sort
+{
+public:
+    /**
+     * @brief Sorts a range of bigint values in ascending order.
+     *
+     * The sort isn't stable, which only matters for equal values.
+     *
+     * @tparam RandomIt A random-access iterator over bigint
+     * @param first The beginning of the range
+     * @param last The end of the range
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last)
+    {
+        size_t n = static_cast<size_t>(last - first);
+        if (n < 2)
+            return;
+
+        // Negative values come first, longest first, then zero, then positive values,
+        // shortest first. Within a group of equal length, the leading 18 digits are
+        // compared as one integer held next to the group, so most comparisons don't
+        // touch the digit vectors at all
+        std::vector<entry> entries(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            bigint &value = first[static_cast<std::ptrdiff_t>(i)];
+            size_t length = value.digits();
+            uint64_t lead = 0;
+            for (size_t k = length; k > 0 && k + lead_digits > length; --k)
+                lead = lead * 10 + value.digit(k - 1);
+            int sign = value.sign();
+            entries[i] = {sign * static_cast<int64_t>(length), sign < 0 ? ~lead : lead, std::addressof(value)};
+        }
+        sort_entries(entries);
+
+        std::vector<bigint *> order(n), scratch(n);
+        for (size_t i = 0; i < n; ++i)
+            order[i] = entries[i].value;
+
+        // Values whose leading digits tie are sorted by the remaining digits
+        for (size_t begin = 0; begin < n;)
+        {
+            size_t end = begin + 1;
+            while (end < n && entries[end].group == entries[begin].group && entries[end].lead == entries[begin].lead)
+                ++end;
+            size_t length = order[begin]->digits();
+            if (end - begin > 1 && length > lead_digits)
+                radix(order.data() + begin, scratch.data() + begin, end - begin, length - lead_digits, entries[begin].group < 0);
+            begin = end;
+        }
+
+        std::vector<bigint> sorted;
+        sorted.reserve(n);
+        for (bigint *value : order)
+            sorted.push_back(std::move(*value));
+        std::move(sorted.begin(), sorted.end(), first);
+    }
+
+    /**
+     * @brief Returns a byte string whose lexicographic order is the order of the values.
+     *
+     * The first byte is the sign class, followed for non-zero values by the
+     * number of digits in 8 big-endian bytes and the digits from the most
+     * significant, two per byte. For negative values the length and digits are
+     * complemented, so that larger magnitudes sort first. std::string and
+     * memcmp compare the bytes as unsigned, as required.
+     *
+     * @param value The value
+     * @return std::string The key
+     */
+    static std::string key(const bigint &value)
+    {
+        int sign = value.sign();
+        if (sign == 0)
+            return std::string(1, static_cast<char>(1));
+
+        bool negative = sign < 0;
+        size_t length = value.digits();
+        std::string result(1, static_cast<char>(negative ? 0 : 2));
+        result.reserve(9 + (length + 1) / 2);
+        uint64_t stored_length = negative ? ~static_cast<uint64_t>(length) : static_cast<uint64_t>(length);
+        for (int shift = 56; shift >= 0; shift -= 8)
+            result.push_back(static_cast<char>((stored_length >> shift) & 0xFF));
+        for (size_t i = length; i > 0; i -= std::min<size_t>(i, 2))
+        {
+            unsigned pair = value.digit(i - 1) * 10u + (i >= 2 ? value.digit(i - 2) : 0u);
+            result.push_back(static_cast<char>(negative ? 99 - pair : pair));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the value a key was made from.
+     *
+     * @param key A key returned by key()
+     * @return bigint The value
+     */
+    static bigint from_key(const std::string &key)
+    {
+        if (key.size() == 1 && key[0] == 1)
+            return bigint(0);
+        if (key.size() < 10 || (key[0] != 0 && key[0] != 2))
+            throw std::invalid_argument("Invalid sort key");
+
+        bool negative = key[0] == 0;
+        uint64_t length = 0;
+        for (size_t i = 1; i < 9; ++i)
+            length = (length << 8) | static_cast<unsigned char>(key[i]);
+        if (negative)
+            length = ~length;
+        if (length == 0 || key.size() != 9 + (length + 1) / 2)
+            throw std::invalid_argument("Invalid sort key");
+
+        std::string digits;
+        digits.reserve(length + 2);
+        if (negative)
+            digits.push_back('-');
+        for (size_t i = 9; i < key.size(); ++i)
+        {
+            unsigned pair = static_cast<unsigned char>(key[i]);
+            if (pair > 99)
+                throw std::invalid_argument("Invalid sort key");
+            if (negative)
+                pair = 99 - pair;
+            digits.push_back(static_cast<char>('0' + pair / 10));
+            digits.push_back(static_cast<char>('0' + pair % 10));
+        }
+        if (length % 2 != 0)
+            digits.pop_back();
+        return bigint(digits);
+    }
+
+private:
+    /**
+     * @brief The number of leading digits compared as one integer, the most a uint64_t holds.
+     *
+     */
+    static constexpr size_t lead_digits = 18;
+
+    /**
+     * @brief A value with the keys it's sorted by first.
+     *
+     */
+    struct entry
+    {
+        int64_t group;
+        uint64_t lead;
+        bigint *value;
+    };
+
+    /**
+     * @brief The width in bits of the digits of the radix sort of the entries.
+     *
+     */
+    static constexpr size_t key_bits = 11;
+
+    /**
+     * @brief The number of digits of key_bits covering a 64-bit word.
+     *
+     */
+    static constexpr size_t key_digits = (64 + key_bits - 1) / key_bits;
+
+    /**
+     * @brief Returns one digit of the sort key (group, lead) of an entry.
+     *
+     * @param e The entry
+     * @param d The digit, least significant first; the first key_digits are the lead's
+     * @return size_t The digit
+     */
+    static size_t key_digit(const entry &e, size_t d)
+    {
+        // Flipping the sign bit maps the signed group to an unsigned key of the same order
+        uint64_t word = d < key_digits ? e.lead : static_cast<uint64_t>(e.group) ^ (uint64_t(1) << 63);
+        return static_cast<size_t>((word >> (key_bits * (d % key_digits))) & ((size_t(1) << key_bits) - 1));
+    }
+
+    /**
+     * @brief Sorts entries by group, then lead, with a least-significant-digit radix sort.
+     *
+     * The counts of all digits are taken in one pass, and the digits on which
+     * every entry agrees are skipped, which leaves the few digits of the group
+     * that vary and those of the lead.
+     *
+     * @param entries The entries to sort
+     */
+    static void sort_entries(std::vector<entry> &entries)
+    {
+        constexpr size_t radix_size = size_t(1) << key_bits;
+        size_t n = entries.size();
+        std::vector<size_t> counts(2 * key_digits * radix_size, 0);
+        for (const entry &e : entries)
+            for (size_t d = 0; d < 2 * key_digits; ++d)
+                ++counts[d * radix_size + key_digit(e, d)];
+
+        std::vector<entry> buffer(n);
+        for (size_t d = 0; d < 2 * key_digits; ++d)
+        {
+            size_t *count = counts.data() + d * radix_size;
+            if (count[key_digit(entries[0], d)] == n)
+                continue;
+            size_t offset = 0;
+            for (size_t v = 0; v < radix_size; ++v)
+            {
+                size_t c = count[v];
+                count[v] = offset;
+                offset += c;
+            }
+            for (const entry &e : entries)
+                buffer[count[key_digit(e, d)]++] = e;
+            entries.swap(buffer);
+        }
+    }
+
+    /**
+     * @brief Sorts pointers to values of equal sign and length by their digits.
+     *
+     * Distributes the values into ten buckets by the digit at `pos - 1` and
+     * recurses into each bucket with the next digit. Small buckets are finished
+     * by insertion sort.
+     *
+     * @param values The pointers to sort
+     * @param scratch Storage for as many pointers
+     * @param n The number of pointers
+     * @param pos The number of leading digits not yet known to be equal within `values`
+     * @param descending Whether larger digits come first, for negative values
+     */
+    static void radix(bigint **values, bigint **scratch, size_t n, size_t pos, bool descending)
+    {
+        while (n >= 2 && pos > 0)
+        {
+            if (n < 32)
+            {
+                insertion(values, n, pos, descending);
+                return;
+            }
+
+            size_t count[10] = {};
+            for (size_t i = 0; i < n; ++i)
+                ++count[values[i]->digit(pos - 1)];
+
+            size_t start[10], offset = 0;
+            for (size_t b = 0; b < 10; ++b)
+            {
+                size_t bucket = descending ? 9 - b : b;
+                start[bucket] = offset;
+                offset += count[bucket];
+            }
+            size_t next[10];
+            std::copy(start, start + 10, next);
+            for (size_t i = 0; i < n; ++i)
+                scratch[next[values[i]->digit(pos - 1)]++] = values[i];
+            std::copy(scratch, scratch + n, values);
+
+            // Recurse into all buckets but the largest, which is handled by the loop
+            size_t largest = 0;
+            for (size_t b = 1; b < 10; ++b)
+                if (count[b] > count[largest])
+                    largest = b;
+            for (size_t b = 0; b < 10; ++b)
+                if (b != largest)
+                    radix(values + start[b], scratch + start[b], count[b], pos - 1, descending);
+            values += start[largest];
+            scratch += start[largest];
+            n = count[largest];
+            --pos;
+        }
+    }
+
+    /**
+     * @brief Sorts a few pointers to values of equal sign and length by insertion.
+     *
+     * @param values The pointers to sort
+     * @param n The number of pointers
+     * @param pos The number of leading digits to compare
+     * @param descending Whether larger digits come first, for negative values
+     */
+    static void insertion(bigint **values, size_t n, size_t pos, bool descending)
+    {
+        auto before = [&](const bigint *a, const bigint *b)
+        {
+            for (size_t i = pos; i > 0; --i)
+            {
+                uint8_t da = a->digit(i - 1), db = b->digit(i - 1);
+                if (da != db)
+                    return descending ? da > db : da < db;
+            }
+            return false;
+        };
+        for (size_t i = 1; i < n; ++i)
+        {
+            bigint *value = values[i];
+            size_t j = i;
+            for (; j > 0 && before(value, values[j - 1]); --j)
+                values[j] = values[j - 1];
+            values[j] = value;
+        }
+    }
+};
+
+#endif // BIGINT_SORT_HPP
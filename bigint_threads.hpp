@@ -0,0 +1,105 @@
+/**
+ * @file bigint_threads.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigint_threads
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGINT_THREADS_HPP
+#define BIGINT_THREADS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The thread count and the parallel loop shared by the parallel classes
+ *
+ * bigint_matrix, bigint_scan and bigint_expr all run on get_thread_count()
+ * threads, so one setting controls the parallelism of the library.
+ *
+ */
+class bigint_threads
+{
+public:
+    /**
+     * @brief Sets the number of threads used by the parallel classes.
+     *
+     * @param threads The number of threads, 1 for none (at least 1)
+     */
+    static void set_thread_count(size_t threads)
+    {
+        thread_count = std::max<size_t>(threads, 1);
+    }
+
+    /**
+     * @brief Returns the number of threads used by the parallel classes.
+     *
+     * @return size_t The number of threads, by default the hardware concurrency
+     */
+    static size_t get_thread_count()
+    {
+        return thread_count;
+    }
+
+    /**
+     * @brief Runs a task for every index, split across get_thread_count() threads.
+     *
+     * Thread t runs the indices t, t + threads, t + 2 * threads, ... When a task
+     * throws, its thread stops, the other threads finish their indices, and the
+     * first exception is rethrown once all of them have joined.
+     *
+     * @param count The number of indices
+     * @param task The task, called with each index once
+     */
+    template <typename Task>
+    static void parallel_for(size_t count, Task task)
+    {
+        size_t threads = std::min(thread_count, count);
+        if (threads <= 1)
+        {
+            for (size_t i = 0; i < count; ++i)
+                task(i);
+            return;
+        }
+
+        std::mutex error_lock;
+        std::exception_ptr error;
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&task, &error_lock, &error, t, threads, count]
+                                 {
+                                     try
+                                     {
+                                         for (size_t i = t; i < count; i += threads)
+                                             task(i);
+                                     }
+                                     catch (...)
+                                     {
+                                         std::lock_guard<std::mutex> guard(error_lock);
+                                         if (!error)
+                                             error = std::current_exception();
+                                     } });
+        for (std::thread &worker : workers)
+            worker.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    /**
+     * @brief The number of threads used by the parallel classes.
+     *
+     */
+    inline static size_t thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+};
+
+#endif // BIGINT_THREADS_HPP
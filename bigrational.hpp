@@ -0,0 +1,497 @@
+/**
+ * @file bigrational.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class bigrational
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef BIGRATIONAL_HPP
+#define BIGRATIONAL_HPP
+
+#include "bigint.hpp"
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief A class for arbitrary-precision rational numbers
+ *
+ * The value is stored as a numerator and a positive denominator. Fractions are
+ * reduced lazily: arithmetic results are left unreduced until canonicalize() is
+ * called or the denominator grows beyond the reduce bound. Const members never
+ * write the object, so concurrent reads of a shared bigrational are safe; they
+ * reduce a copy when they need the reduced form. Comparisons cross-multiply and
+ * never need a gcd.
+ *
+ */
+class bigrational
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * Outputs the reduced fraction as `numerator/denominator`, or only the
+     * numerator if the value is an integer.
+     *
+     * @param out an instance of std::ostream
+     * @param num the bigrational object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const bigrational &num)
+    {
+        std::pair<bigint, bigint> parts = num.reduced_parts();
+        out << parts.first;
+        if (parts.second != 1)
+            out << '/' << parts.second;
+        return out;
+    }
+
+public:
+    /**
+     * @brief Checks if two bigrational numbers are equal
+     *
+     * @param rhs The bigrational to compare with
+     * @return true if both bigrational numbers are equal
+     * @return false otherwise
+     */
+    bool operator==(const bigrational &rhs) const
+    {
+        // Reduced forms are unique, so they can be compared field by field
+        if (reduced && rhs.reduced)
+            return num == rhs.num && den == rhs.den;
+        return num * rhs.den == rhs.num * den;
+    }
+
+    /**
+     * @brief Check if two bigrational numbers are not equal
+     *
+     * @param rhs The bigrational to compare with
+     * @return true if the bigrational numbers are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const bigrational &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Compares if the current bigrational is less than the given bigrational
+     *
+     * @param rhs The bigrational to compare with
+     * @return true if the current bigrational is less than the given bigrational
+     * @return false otherwise
+     */
+    bool operator<(const bigrational &rhs) const
+    {
+        // Denominators are positive, so cross-multiplying keeps the order
+        if (den == rhs.den)
+            return num < rhs.num;
+        return num * rhs.den < rhs.num * den;
+    }
+
+    /**
+     * @brief Compares if the current bigrational is less than or equal to the given bigrational
+     *
+     * @param rhs The bigrational to compare with
+     * @return true if the current bigrational is less than or equal to the given bigrational
+     * @return false otherwise
+     */
+    bool operator<=(const bigrational &rhs) const
+    {
+        return !(rhs < *this);
+    }
+
+    /**
+     * @brief Compares if the current bigrational is greater than the given bigrational
+     *
+     * @param rhs The bigrational to compare with
+     * @return true if the current bigrational is greater than the given bigrational
+     * @return false otherwise
+     */
+    bool operator>(const bigrational &rhs) const
+    {
+        return rhs < *this;
+    }
+
+    /**
+     * @brief Compares if the current bigrational is greater than or equal to the given bigrational
+     *
+     * @param rhs The bigrational to compare with
+     * @return true if the current bigrational is greater than or equal to the given bigrational
+     * @return false otherwise
+     */
+    bool operator>=(const bigrational &rhs) const
+    {
+        return !(*this < rhs);
+    }
+
+    /**
+     * @brief Adds two bigrational numbers
+     *
+     * @param rhs The bigrational to add to the current bigrational
+     * @return bigrational A new one representing the sum
+     */
+    bigrational operator+(const bigrational &rhs) const
+    {
+        // Integers and a common denominator only need the numerators added
+        if (den == rhs.den)
+        {
+            if (den == 1)
+                return bigrational(num + rhs.num, den, true);
+            return bigrational(num + rhs.num, den, false);
+        }
+
+        // An integer plus a reduced fraction c/d gives (a*d + c)/d, which stays reduced
+        if (rhs.den == 1)
+            return bigrational(num + rhs.num * den, den, reduced);
+        if (den == 1)
+            return bigrational(num * rhs.den + rhs.num, rhs.den, rhs.reduced);
+
+        return bigrational(num * rhs.den + rhs.num * den, den * rhs.den, false);
+    }
+
+    /**
+     * @brief Subtracts the given bigrational from the current bigrational
+     *
+     * @param rhs The bigrational to subtract
+     * @return bigrational A new one representing the difference
+     */
+    bigrational operator-(const bigrational &rhs) const
+    {
+        return *this + -rhs;
+    }
+
+    /**
+     * @brief Multiplies two bigrational numbers
+     *
+     * @param rhs The bigrational to multiply with the current bigrational
+     * @return bigrational A new one representing the product
+     */
+    bigrational operator*(const bigrational &rhs) const
+    {
+        if (den == 1 && rhs.den == 1)
+            return bigrational(num * rhs.num, den, true);
+        return multiply(num, den, reduced, rhs.num, rhs.den, rhs.reduced);
+    }
+
+    /**
+     * @brief Divides the current bigrational by the given bigrational
+     *
+     * @param rhs The bigrational divisor
+     * @return bigrational A new one representing the quotient
+     */
+    bigrational operator/(const bigrational &rhs) const
+    {
+        // Handle the division by zero
+        if (rhs.num == 0)
+            throw std::invalid_argument("Division by zero");
+
+        // Multiply by the reciprocal, moving its sign to the numerator
+        if (rhs.num < 0)
+            return multiply(num, den, reduced, -rhs.den, -rhs.num, rhs.reduced);
+        return multiply(num, den, reduced, rhs.den, rhs.num, rhs.reduced);
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return bigrational& A reference to the current object after the operation
+     */
+    bigrational &operator+=(const bigrational &rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return bigrational& A reference to the current object after the operation
+     */
+    bigrational &operator-=(const bigrational &rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return bigrational& A reference to the current object after the operation
+     */
+    bigrational &operator*=(const bigrational &rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment /= overloading
+     *
+     * @param rhs right hand side
+     * @return bigrational& A reference to the current object after the operation
+     */
+    bigrational &operator/=(const bigrational &rhs)
+    {
+        *this = *this / rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return bigrational A negated bigrational value
+     */
+    bigrational operator-() const
+    {
+        return bigrational(-num, den, reduced);
+    }
+
+    /**
+     * @brief Returns the numerator of the reduced fraction.
+     *
+     * @return bigint The numerator, carrying the sign of the value
+     */
+    bigint numerator() const
+    {
+        return reduced_parts().first;
+    }
+
+    /**
+     * @brief Returns the denominator of the reduced fraction.
+     *
+     * @return bigint The denominator, always positive
+     */
+    bigint denominator() const
+    {
+        return reduced_parts().second;
+    }
+
+    /**
+     * @brief Checks whether the value is an integer.
+     *
+     * @return true if the reduced denominator is 1
+     * @return false otherwise
+     */
+    bool is_integer() const
+    {
+        if (den == 1)
+            return true;
+        if (reduced)
+            return false;
+        return bigint::gcd(num, den) == den;
+    }
+
+    /**
+     * @brief Reduces the fraction by the gcd of its numerator and denominator.
+     *
+     * Does nothing if the fraction is already known to be reduced. Reducing once
+     * saves the gcd that numerator(), denominator() and to_string() otherwise
+     * compute on every call of an unreduced value.
+     *
+     */
+    void canonicalize()
+    {
+        if (reduced)
+            return;
+        bigint g = bigint::gcd(num, den);
+        if (g != 1)
+        {
+            num /= g;
+            den /= g;
+        }
+        reduced = true;
+    }
+
+    /**
+     * @brief Converts the bigrational to its string representation.
+     *
+     * @return std::string The reduced fraction as "numerator/denominator", or
+     * only the numerator if the value is an integer.
+     */
+    std::string to_string() const
+    {
+        std::pair<bigint, bigint> parts = reduced_parts();
+        if (parts.second == 1)
+            return parts.first.to_string(10);
+        return parts.first.to_string(10) + "/" + parts.second.to_string(10);
+    }
+
+    /**
+     * @brief Sets the number of denominator digits an unreduced result may reach.
+     *
+     * Results whose denominator has more digits are reduced right away. A small
+     * bound reduces often and keeps operands small; a large bound skips more gcds.
+     *
+     * @param digits The new bound in decimal digits
+     */
+    static void set_reduce_bound(size_t digits)
+    {
+        reduce_bound = digits;
+    }
+
+    /**
+     * @brief Returns the number of denominator digits an unreduced result may reach.
+     *
+     * @return size_t The bound in decimal digits
+     */
+    static size_t get_reduce_bound()
+    {
+        return reduce_bound;
+    }
+
+    /**
+     * @brief Construct a new bigrational object with an initial value of 0.
+     *
+     */
+    bigrational() : num(0), den(1), reduced(true) {}
+
+    /**
+     * @brief Construct a new bigrational object from a signed 64-bit integer.
+     *
+     * @param value The integer value
+     */
+    bigrational(int64_t value) : num(value), den(1), reduced(true) {}
+
+    /**
+     * @brief Construct a new bigrational object from a bigint.
+     *
+     * @param value The integer value
+     */
+    bigrational(const bigint &value) : num(value), den(1), reduced(true) {}
+
+    /**
+     * @brief Construct a new bigrational object from a numerator and a denominator.
+     *
+     * The fraction doesn't need to be reduced, and the denominator may be negative.
+     *
+     * @param numerator The numerator
+     * @param denominator The denominator, must not be zero
+     */
+    bigrational(const bigint &numerator, const bigint &denominator) : num(numerator), den(denominator), reduced(false)
+    {
+        if (den == 0)
+            throw std::invalid_argument("Denominator cannot be zero!");
+        if (den < 0)
+        {
+            num = -num;
+            den = -den;
+        }
+        reduced = den == 1;
+        bound();
+    }
+
+    /**
+     * @brief Construct a new bigrational object from a string representation.
+     *
+     * @param str The string representing the number, either an integer such as
+     * "-12" or a fraction such as "-12/34".
+     */
+    bigrational(const std::string &str) : bigrational()
+    {
+        size_t slash = str.find('/');
+        if (slash == std::string::npos)
+            *this = bigrational(bigint(str));
+        else
+            *this = bigrational(bigint(str.substr(0, slash)), bigint(str.substr(slash + 1)));
+    }
+
+private:
+    /**
+     * @brief The numerator, carrying the sign of the value.
+     *
+     */
+    bigint num;
+
+    /**
+     * @brief The denominator, always positive.
+     *
+     */
+    bigint den;
+
+    /**
+     * @brief Whether the fraction is known to be reduced.
+     *
+     */
+    bool reduced;
+
+    /**
+     * @brief The number of denominator digits an unreduced result may reach.
+     *
+     */
+    inline static size_t reduce_bound = 64;
+
+    /**
+     * @brief Construct a new bigrational object from parts that are already normalized.
+     *
+     * @param numerator The numerator
+     * @param denominator The positive denominator
+     * @param is_reduced Whether the fraction is known to be reduced
+     */
+    bigrational(bigint numerator, bigint denominator, bool is_reduced)
+        : num(std::move(numerator)), den(std::move(denominator)), reduced(is_reduced)
+    {
+        bound();
+    }
+
+    /**
+     * @brief Returns the reduced numerator and denominator without modifying the object.
+     *
+     * @return std::pair<bigint, bigint> The reduced numerator and positive denominator
+     */
+    std::pair<bigint, bigint> reduced_parts() const
+    {
+        if (reduced)
+            return {num, den};
+        bigint g = bigint::gcd(num, den);
+        if (g == 1)
+            return {num, den};
+        return {num / g, den / g};
+    }
+
+    /**
+     * @brief Reduces the fraction if its denominator grew beyond the reduce bound.
+     *
+     */
+    void bound()
+    {
+        if (!reduced && den.digits() > reduce_bound)
+            canonicalize();
+    }
+
+    /**
+     * @brief Multiplies a/b by c/d.
+     *
+     * If both fractions are reduced, the cross gcds g1 = gcd(a, d) and g2 = gcd(c, b)
+     * are divided out before multiplying, which yields a reduced product from two
+     * gcds on the smaller operands instead of one on the full product.
+     *
+     * @param a The first numerator
+     * @param b The first denominator, positive
+     * @param ab_reduced Whether a/b is reduced
+     * @param c The second numerator
+     * @param d The second denominator, positive
+     * @param cd_reduced Whether c/d is reduced
+     * @return bigrational The product
+     */
+    static bigrational multiply(const bigint &a, const bigint &b, bool ab_reduced,
+                                const bigint &c, const bigint &d, bool cd_reduced)
+    {
+        if (!ab_reduced || !cd_reduced)
+            return bigrational(a * c, b * d, false);
+
+        bigint g1 = d == 1 ? bigint(1) : bigint::gcd(a, d);
+        bigint g2 = b == 1 ? bigint(1) : bigint::gcd(c, b);
+        if (g1 == 1 && g2 == 1)
+            return bigrational(a * c, b * d, true);
+        return bigrational((a / g1) * (c / g2), (b / g2) * (d / g1), true);
+    }
+};
+
+#endif // BIGRATIONAL_HPP
@@ -0,0 +1,539 @@
+/**
+ * @file disk_bigint.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class disk_bigint
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef DISK_BIGINT_HPP
+#define DISK_BIGINT_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief An integer whose digits live in a memory-mapped temporary file
+ *
+ * The digits are stored like those of bigint, one byte per decimal digit with
+ * the least significant first, but in an unlinked file mapped into memory, so
+ * the operating system can page them out. The file disappears when the object
+ * is destroyed. It is created in $TMPDIR or /tmp by default, which is often a
+ * tmpfs backed by memory and swap; pass a directory on a disk file system for
+ * digits that must not take memory. Values are built from a bigint or a
+ * string, so an operand has to fit in memory once when it is created, while
+ * products of such values need not.
+ *
+ * Multiplication works on blocks of digits: the product of every pair of
+ * blocks is computed in memory with a number-theoretic transform and added
+ * into the product file, so memory use is bounded by the block size whatever
+ * the size of the operands. It isn't a full out-of-core transform, though:
+ * every block of one factor is read and transformed again for every block of
+ * the other, so factors of n and m digits with blocks of B digits cost
+ * (n / B) * (m / B) block products of O(B log B) each. This is quadratic in the
+ * number of blocks and compute-bound; two factors of a billion digits with the
+ * default block take about 1.6 million block products.
+ *
+ * Only available on POSIX systems.
+ *
+ */
+class disk_bigint
+{
+public:
+    /**
+     * @brief Returns the number of decimal digits of the absolute value.
+     *
+     * Zero has one digit; a moved-from object has none.
+     *
+     * @return size_t The number of digits
+     */
+    size_t digits() const
+    {
+        return len;
+    }
+
+    /**
+     * @brief Returns a decimal digit of the absolute value.
+     *
+     * @param i The position of the digit, 0 being the least significant one
+     * @return uint8_t The digit, or 0 past the most significant digit
+     */
+    uint8_t digit(size_t i) const
+    {
+        return i < len ? data[i] : 0;
+    }
+
+    /**
+     * @brief Returns the sign of the value.
+     *
+     * @return int -1 for a negative value, 0 for zero and 1 for a positive value
+     */
+    int sign() const
+    {
+        if (negative)
+            return -1;
+        return len == 0 || (len == 1 && data[0] == 0) ? 0 : 1;
+    }
+
+    /**
+     * @brief Converts the value to an in-memory bigint.
+     *
+     * @return bigint The value, which must fit in memory
+     */
+    bigint to_bigint() const
+    {
+        if (len == 0)
+            return bigint();
+        return bigint(negative, std::vector<uint8_t>(data, data + len));
+    }
+
+    /**
+     * @brief Writes the decimal representation to a stream, a chunk at a time.
+     *
+     * @param out The stream to write to
+     */
+    void write(std::ostream &out) const
+    {
+        if (len == 0)
+        {
+            out << '0';
+            return;
+        }
+        if (negative)
+            out << '-';
+        char chunk[1 << 16];
+        for (size_t i = len; i > 0;)
+        {
+            size_t count = std::min(i, sizeof(chunk));
+            for (size_t k = 0; k < count; ++k)
+                chunk[k] = static_cast<char>('0' + data[i - 1 - k]);
+            out.write(chunk, static_cast<std::streamsize>(count));
+            i -= count;
+        }
+    }
+
+    /**
+     * @brief Multiplies two numbers out of core.
+     *
+     * Uses get_block_digits() digits per block.
+     *
+     * @param rhs The number to multiply with the current one
+     * @return disk_bigint A new one representing the product
+     */
+    disk_bigint operator*(const disk_bigint &rhs) const
+    {
+        return multiply(*this, rhs, block_digits);
+    }
+
+    /**
+     * @brief Multiplies two numbers, block by block.
+     *
+     * Every block of `a` is transformed once, and every block of `b` is read
+     * and transformed once per block of `a`. The product of each pair of blocks
+     * is added into the product file with carry propagation.
+     *
+     * @param a The first factor
+     * @param b The second factor
+     * @param block The number of digits per block, bounding the memory used
+     * @param directory The directory of the product file, empty for the default one
+     * @return disk_bigint A new one representing the product
+     */
+    static disk_bigint multiply(const disk_bigint &a, const disk_bigint &b, size_t block, const std::string &directory = "")
+    {
+        block = clamp_block(block);
+        disk_bigint product;
+        product.map(a.len + b.len, directory);
+        product.negative = a.negative != b.negative;
+
+        // The transforms are sized for the longest blocks the operands actually have
+        size_t limbs = (std::min(block, a.len) + 2) / 3 + (std::min(block, b.len) + 2) / 3;
+        size_t size = 1;
+        while (size < limbs)
+            size <<= 1;
+
+        std::vector<uint64_t> fa1(size), fa2(size), fb1(size), fb2(size);
+        std::vector<uint64_t> coefficients(size);
+        for (size_t ia = 0; ia < a.len; ia += block)
+        {
+            size_t na = std::min(block, a.len - ia);
+            load_limbs(a.data + ia, na, fa1);
+            fa2 = fa1;
+            ntt(fa1, p1, false);
+            ntt(fa2, p2, false);
+
+            for (size_t ib = 0; ib < b.len; ib += block)
+            {
+                size_t nb = std::min(block, b.len - ib);
+                load_limbs(b.data + ib, nb, fb1);
+                fb2 = fb1;
+                ntt(fb1, p1, false);
+                ntt(fb2, p2, false);
+                for (size_t k = 0; k < size; ++k)
+                {
+                    fb1[k] = fb1[k] * fa1[k] % p1;
+                    fb2[k] = fb2[k] * fa2[k] % p2;
+                }
+                ntt(fb1, p1, true);
+                ntt(fb2, p2, true);
+
+                // Garner's algorithm: the exact coefficients are below p1 * p2
+                size_t count = (na + 2) / 3 + (nb + 2) / 3 - 1;
+                for (size_t k = 0; k < count; ++k)
+                {
+                    uint64_t r1 = fb1[k], r2 = fb2[k];
+                    uint64_t t = (r2 + p2 - r1 % p2) % p2 * p1_inverse % p2;
+                    coefficients[k] = r1 + p1 * t;
+                }
+                product.add_limbs(ia + ib, coefficients.data(), count);
+            }
+        }
+        product.trim();
+        return product;
+    }
+
+    /**
+     * @brief Sets the default number of digits per block of operator*.
+     *
+     * A product uses 30 to 60 bytes of memory per digit of block, for the
+     * transforms of two blocks; the default of 786432 digits takes about 23 MB.
+     *
+     * @param digits The new block size (between 3 and about 12 million)
+     */
+    static void set_block_digits(size_t digits)
+    {
+        block_digits = clamp_block(digits);
+    }
+
+    /**
+     * @brief Returns the default number of digits per block of operator*.
+     *
+     * @return size_t The block size
+     */
+    static size_t get_block_digits()
+    {
+        return block_digits;
+    }
+
+    /**
+     * @brief Construct a new disk_bigint object holding a copy of a bigint.
+     *
+     * @param value The value
+     * @param directory The directory of the digit file, empty for $TMPDIR or /tmp
+     */
+    explicit disk_bigint(const bigint &value, const std::string &directory = "")
+    {
+        map(value.digits(), directory);
+        for (size_t i = 0; i < len; ++i)
+            data[i] = value.digit(i);
+        negative = value.sign() < 0;
+    }
+
+    /**
+     * @brief Construct a new disk_bigint object from a decimal string.
+     *
+     * @param str The decimal string, digits with an optional leading '-' or '+'
+     * @param directory The directory of the digit file, empty for $TMPDIR or /tmp
+     */
+    explicit disk_bigint(const std::string &str, const std::string &directory = "")
+    {
+        size_t start = !str.empty() && (str[0] == '-' || str[0] == '+') ? 1 : 0;
+        if (str.size() == start)
+            throw std::invalid_argument("Invalid input string");
+
+        // Validate before mapping: a throwing constructor doesn't run the destructor that unmaps
+        for (size_t i = start; i < str.size(); ++i)
+            if (str[i] < '0' || str[i] > '9')
+                throw std::invalid_argument("Invalid input string");
+        map(str.size() - start, directory);
+        for (size_t i = 0; i < len; ++i)
+            data[i] = static_cast<uint8_t>(str[str.size() - 1 - i] - '0');
+        negative = str[0] == '-';
+        trim();
+    }
+
+    disk_bigint(const disk_bigint &) = delete;
+    disk_bigint &operator=(const disk_bigint &) = delete;
+
+    /**
+     * @brief Construct a new disk_bigint object taking the file of another.
+     *
+     * The source is left empty, without a file: digit(), sign(), to_bigint() and
+     * write() read it as zero, and it may otherwise only be destroyed or assigned to.
+     *
+     * @param other The object to move from
+     */
+    disk_bigint(disk_bigint &&other) noexcept : data(other.data), capacity(other.capacity), len(other.len), negative(other.negative)
+    {
+        other.data = nullptr;
+        other.capacity = 0;
+        other.len = 0;
+        other.negative = false;
+    }
+
+    /**
+     * @brief Takes the file of another object.
+     *
+     * @param other The object to move from
+     * @return disk_bigint& A reference to the current object after the operation
+     */
+    disk_bigint &operator=(disk_bigint &&other) noexcept
+    {
+        std::swap(data, other.data);
+        std::swap(capacity, other.capacity);
+        std::swap(len, other.len);
+        std::swap(negative, other.negative);
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the disk_bigint object, unmapping its file.
+     *
+     */
+    ~disk_bigint()
+    {
+        if (data)
+            munmap(data, capacity);
+    }
+
+private:
+    /**
+     * @brief The two NTT primes, both 1 modulo 2^23, with 3 as a primitive root.
+     *
+     * A product coefficient of two blocks of base-1000 limbs is below
+     * 999^2 * 2^22, far below p1 * p2, so two primes determine it exactly.
+     *
+     */
+    static constexpr uint64_t p1 = 998244353, p2 = 469762049;
+
+    /**
+     * @brief The inverse of p1 modulo p2.
+     *
+     */
+    static constexpr uint64_t p1_inverse = 208783132;
+
+    /**
+     * @brief The largest block, for which the transforms have 2^23 points.
+     *
+     */
+    static constexpr size_t max_block = 3 * (size_t(1) << 22);
+
+    /**
+     * @brief The default number of digits per block of operator*.
+     *
+     */
+    inline static size_t block_digits = 3 * (size_t(1) << 18);
+
+    /**
+     * @brief The mapped digits, least significant first.
+     *
+     */
+    uint8_t *data = nullptr;
+
+    /**
+     * @brief The size of the mapping in bytes.
+     *
+     */
+    size_t capacity = 0;
+
+    /**
+     * @brief The number of digits, without leading zeros.
+     *
+     */
+    size_t len = 0;
+
+    /**
+     * @brief Indicates whether the value is negative.
+     *
+     */
+    bool negative = false;
+
+    /**
+     * @brief Construct a new disk_bigint object without a file, for map() to give it one.
+     *
+     */
+    disk_bigint() = default;
+
+    /**
+     * @brief Maps a new file with room for some digits, all zero.
+     *
+     * The file is created with mkstemp, unlinked at once and extended with
+     * ftruncate, so it holds no disk blocks until digits are written.
+     *
+     * @param digits The number of digits
+     * @param directory The directory of the digit file, empty for $TMPDIR or /tmp
+     */
+    void map(size_t digits, const std::string &directory)
+    {
+        std::string dir = directory;
+        if (dir.empty())
+        {
+            const char *tmpdir = std::getenv("TMPDIR");
+            dir = tmpdir && *tmpdir ? tmpdir : "/tmp";
+        }
+        std::string path = dir + "/bigint-XXXXXX";
+        int fd = mkstemp(path.data());
+        if (fd < 0)
+            throw std::runtime_error("Cannot create a digit file in " + dir);
+        unlink(path.c_str());
+
+        size_t size = std::max<size_t>(digits, 1);
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            close(fd);
+            throw std::runtime_error("Cannot extend a digit file in " + dir);
+        }
+        void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("Cannot map a digit file in " + dir);
+        data = static_cast<uint8_t *>(mapping);
+        capacity = len = size;
+        madvise(data, capacity, MADV_SEQUENTIAL);
+    }
+
+    /**
+     * @brief Removes leading zeros from the digit count, and the sign of zero.
+     *
+     */
+    void trim()
+    {
+        while (len > 1 && data[len - 1] == 0)
+            --len;
+        if (len == 1 && data[0] == 0)
+            negative = false;
+    }
+
+    /**
+     * @brief Clamps a block size to the range the transforms support.
+     *
+     * @param block The requested number of digits per block
+     * @return size_t A multiple of 3 between 3 and max_block
+     */
+    static size_t clamp_block(size_t block)
+    {
+        block = std::min(std::max<size_t>(block, 3), max_block);
+        return block - block % 3;
+    }
+
+    /**
+     * @brief Packs digits into base-1000 limbs, zero-padding the rest of the array.
+     *
+     * @param digits The digits, least significant first
+     * @param n The number of digits
+     * @param limbs The array to fill, least significant limb first
+     */
+    static void load_limbs(const uint8_t *digits, size_t n, std::vector<uint64_t> &limbs)
+    {
+        std::fill(limbs.begin(), limbs.end(), 0);
+        for (size_t i = 0; i < n; ++i)
+            limbs[i / 3] += digits[i] * (i % 3 == 0 ? 1u : i % 3 == 1 ? 10u : 100u);
+    }
+
+    /**
+     * @brief Adds base-1000 coefficients into the digits at a digit offset, propagating the carry.
+     *
+     * @param offset The digit at which the first coefficient is added
+     * @param coefficients The coefficients, least significant first
+     * @param count The number of coefficients
+     */
+    void add_limbs(size_t offset, const uint64_t *coefficients, size_t count)
+    {
+        uint64_t carry = 0;
+        for (size_t d = 0; (d < 3 * count || carry) && offset + d < capacity; ++d)
+        {
+            if (d % 3 == 0 && d / 3 < count)
+                carry += coefficients[d / 3];
+            uint64_t t = data[offset + d] + carry % 10;
+            data[offset + d] = static_cast<uint8_t>(t % 10);
+            carry = carry / 10 + t / 10;
+        }
+    }
+
+    /**
+     * @brief Computes a modular power.
+     *
+     * @param base The base
+     * @param exponent The exponent
+     * @param p The modulus, below 2^32
+     * @return uint64_t base^exponent modulo p
+     */
+    static uint64_t power(uint64_t base, uint64_t exponent, uint64_t p)
+    {
+        uint64_t result = 1;
+        base %= p;
+        for (; exponent; exponent >>= 1)
+        {
+            if (exponent & 1)
+                result = result * base % p;
+            base = base * base % p;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Transforms an array in place with the number-theoretic transform.
+     *
+     * The iterative radix-2 transform over the integers modulo p, whose size is
+     * a power of two dividing p - 1. The inverse transform includes the
+     * division by the size.
+     *
+     * @param a The array, of values below p
+     * @param p The prime modulus, with 3 as a primitive root
+     * @param inverse Whether to compute the inverse transform
+     */
+    static void ntt(std::vector<uint64_t> &a, uint64_t p, bool inverse)
+    {
+        size_t n = a.size();
+        for (size_t i = 1, j = 0; i < n; ++i)
+        {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                std::swap(a[i], a[j]);
+        }
+
+        std::vector<uint64_t> roots(n / 2 + 1);
+        for (size_t length = 2; length <= n; length <<= 1)
+        {
+            uint64_t root = power(3, (p - 1) / length, p);
+            if (inverse)
+                root = power(root, p - 2, p);
+            size_t half = length / 2;
+            roots[0] = 1;
+            for (size_t k = 1; k < half; ++k)
+                roots[k] = roots[k - 1] * root % p;
+            for (size_t start = 0; start < n; start += length)
+                for (size_t k = 0; k < half; ++k)
+                {
+                    uint64_t u = a[start + k], v = a[start + k + half] * roots[k] % p;
+                    a[start + k] = u + v < p ? u + v : u + v - p;
+                    a[start + k + half] = u >= v ? u - v : u + p - v;
+                }
+        }
+
+        if (inverse)
+        {
+            uint64_t scale = power(n, p - 2, p);
+            for (uint64_t &x : a)
+                x = x * scale % p;
+        }
+    }
+};
+
+#endif // DISK_BIGINT_HPP
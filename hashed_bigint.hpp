@@ -0,0 +1,232 @@
+/**
+ * @file hashed_bigint.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class hashed_bigint and the hash functors for bigint keys
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef HASHED_BIGINT_HPP
+#define HASHED_BIGINT_HPP
+
+#include "bigint.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+/**
+ * @brief An immutable bigint that carries its hash
+ *
+ * The hash is computed once at construction, so rehashing a container or
+ * probing it with the same key doesn't read the digits again, and unequal
+ * values are usually told apart by their hashes without comparing digits.
+ *
+ */
+class hashed_bigint
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * @param out an instance of std::ostream
+     * @param num the hashed_bigint object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const hashed_bigint &num)
+    {
+        return out << num.val;
+    }
+
+public:
+    /**
+     * @brief Checks if two hashed_bigint numbers are equal
+     *
+     * The hashes are compared first, so unequal values rarely reach the digits.
+     *
+     * @param rhs The hashed_bigint to compare with
+     * @return true if both numbers are equal
+     * @return false otherwise
+     */
+    bool operator==(const hashed_bigint &rhs) const
+    {
+        return h == rhs.h && val == rhs.val;
+    }
+
+    /**
+     * @brief Check if two hashed_bigint numbers are not equal
+     *
+     * @param rhs The hashed_bigint to compare with
+     * @return true if the numbers are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const hashed_bigint &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Compares if the current number is less than the given one
+     *
+     * @param rhs The hashed_bigint to compare with
+     * @return true if the current number is less than the given one
+     * @return false otherwise
+     */
+    bool operator<(const hashed_bigint &rhs) const
+    {
+        return val < rhs.val;
+    }
+
+    /**
+     * @brief Returns the value.
+     *
+     * @return const bigint& The value
+     */
+    const bigint &value() const
+    {
+        return val;
+    }
+
+    /**
+     * @brief Returns the cached hash, equal to value().hash().
+     *
+     * @return size_t The hash
+     */
+    size_t hash() const
+    {
+        return h;
+    }
+
+    /**
+     * @brief Construct a new hashed_bigint object with an initial value of 0.
+     *
+     */
+    hashed_bigint() : h(bigint::hash(0)) {}
+
+    /**
+     * @brief Construct a new hashed_bigint object from a bigint.
+     *
+     * @param value The value, which is hashed once here
+     */
+    hashed_bigint(bigint value) : val(std::move(value)), h(val.hash()) {}
+
+    /**
+     * @brief Construct a new hashed_bigint object from a signed 64-bit integer.
+     *
+     * @param num The signed 64-bit integer
+     */
+    hashed_bigint(int64_t num) : val(num), h(bigint::hash(num)) {}
+
+private:
+    /**
+     * @brief The value.
+     *
+     */
+    bigint val;
+
+    /**
+     * @brief The hash of the value.
+     *
+     */
+    size_t h;
+};
+
+/**
+ * @brief A transparent hash functor for bigint, hashed_bigint and int64_t keys
+ *
+ * All three give the same hash for the same value, and int64_t keys are hashed
+ * without constructing a bigint. Together with bigint_equal, unordered
+ * containers keyed by bigint or hashed_bigint can be probed with any of them
+ * through heterogeneous lookup (C++20 and later).
+ *
+ */
+struct bigint_hash
+{
+    using is_transparent = void;
+
+    size_t operator()(const bigint &value) const
+    {
+        return value.hash();
+    }
+
+    size_t operator()(const hashed_bigint &value) const
+    {
+        return value.hash();
+    }
+
+    size_t operator()(int64_t num) const
+    {
+        return bigint::hash(num);
+    }
+};
+
+/**
+ * @brief A transparent equality functor for bigint, hashed_bigint and int64_t keys
+ *
+ * Comparisons with int64_t don't construct a bigint.
+ *
+ */
+struct bigint_equal
+{
+    using is_transparent = void;
+
+    bool operator()(const bigint &lhs, const bigint &rhs) const
+    {
+        return lhs == rhs;
+    }
+
+    bool operator()(const hashed_bigint &lhs, const hashed_bigint &rhs) const
+    {
+        return lhs == rhs;
+    }
+
+    bool operator()(const bigint &lhs, const hashed_bigint &rhs) const
+    {
+        return lhs == rhs.value();
+    }
+
+    bool operator()(const hashed_bigint &lhs, const bigint &rhs) const
+    {
+        return lhs.value() == rhs;
+    }
+
+    bool operator()(const bigint &lhs, int64_t rhs) const
+    {
+        return lhs.equals(rhs);
+    }
+
+    bool operator()(int64_t lhs, const bigint &rhs) const
+    {
+        return rhs.equals(lhs);
+    }
+
+    bool operator()(const hashed_bigint &lhs, int64_t rhs) const
+    {
+        return lhs.value().equals(rhs);
+    }
+
+    bool operator()(int64_t lhs, const hashed_bigint &rhs) const
+    {
+        return rhs.value().equals(lhs);
+    }
+};
+
+namespace std
+{
+    /**
+     * @brief Returns the cached hash of a hashed_bigint.
+     *
+     */
+    template <>
+    struct hash<hashed_bigint>
+    {
+        size_t operator()(const hashed_bigint &value) const
+        {
+            return value.hash();
+        }
+    };
+}
+
+#endif // HASHED_BIGINT_HPP
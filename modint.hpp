@@ -0,0 +1,876 @@
+/**
+ * @file modint.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the classes modint, montgomery_context and dyn_modint
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef MODINT_HPP
+#define MODINT_HPP
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A class for integers modulo a compile-time constant
+ *
+ * For an odd modulus below 2^63 the value is kept in Montgomery form `a * 2^64 mod
+ * Modulus`, so a multiplication reduces with two 64-bit multiplications and a
+ * shift instead of a 128-bit division. Other moduli reduce with `%` on the 128-bit
+ * product.
+ *
+ * @tparam Modulus The modulus, greater than 1
+ */
+template <uint64_t Modulus>
+class modint
+{
+    static_assert(Modulus > 1, "The modulus must be greater than 1");
+
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * @param out an instance of std::ostream
+     * @param num the modint object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const modint &num)
+    {
+        return out << num.value();
+    }
+
+public:
+    /**
+     * @brief Checks if two modint numbers are equal
+     *
+     * @param rhs The modint to compare with
+     * @return true if both modint numbers are equal
+     * @return false otherwise
+     */
+    bool operator==(const modint &rhs) const
+    {
+        return v == rhs.v;
+    }
+
+    /**
+     * @brief Check if two modint numbers are not equal
+     *
+     * @param rhs The modint to compare with
+     * @return true if the modint numbers are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const modint &rhs) const
+    {
+        return v != rhs.v;
+    }
+
+    /**
+     * @brief Adds two modint numbers
+     *
+     * @param rhs The modint to add to the current modint
+     * @return modint A new one representing the sum
+     */
+    modint operator+(const modint &rhs) const
+    {
+        // The sum may wrap around 2^64 when the modulus is above 2^63
+        uint64_t sum = v + rhs.v;
+        if (sum < v || sum >= Modulus)
+            sum -= Modulus;
+        return from_form(sum);
+    }
+
+    /**
+     * @brief Subtracts the given modint from the current modint
+     *
+     * @param rhs The modint to subtract
+     * @return modint A new one representing the difference
+     */
+    modint operator-(const modint &rhs) const
+    {
+        return from_form(v >= rhs.v ? v - rhs.v : v + (Modulus - rhs.v));
+    }
+
+    /**
+     * @brief Multiplies two modint numbers
+     *
+     * @param rhs The modint to multiply with the current modint
+     * @return modint A new one representing the product
+     */
+    modint operator*(const modint &rhs) const
+    {
+        return from_form(multiply(v, rhs.v));
+    }
+
+    /**
+     * @brief Divides the current modint by the given modint
+     *
+     * @param rhs The modint divisor, which must be invertible
+     * @return modint A new one representing the quotient
+     */
+    modint operator/(const modint &rhs) const
+    {
+        return *this * rhs.inverse();
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return modint& A reference to the current object after the operation
+     */
+    modint &operator+=(const modint &rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return modint& A reference to the current object after the operation
+     */
+    modint &operator-=(const modint &rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return modint& A reference to the current object after the operation
+     */
+    modint &operator*=(const modint &rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment /= overloading
+     *
+     * @param rhs right hand side
+     * @return modint& A reference to the current object after the operation
+     */
+    modint &operator/=(const modint &rhs)
+    {
+        *this = *this / rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return modint A negated modint value
+     */
+    modint operator-() const
+    {
+        return from_form(v == 0 ? 0 : Modulus - v);
+    }
+
+    /**
+     * @brief Raises the modint to a power by repeated squaring.
+     *
+     * @param exponent The exponent
+     * @return modint The power, with 0^0 = 1
+     */
+    modint pow(uint64_t exponent) const
+    {
+        uint64_t base = v;
+        uint64_t result = to_form(1);
+        for (; exponent > 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+                result = multiply(result, base);
+            base = multiply(base, base);
+        }
+        return from_form(result);
+    }
+
+    /**
+     * @brief Computes the multiplicative inverse with the extended Euclidean algorithm.
+     *
+     * @return modint The inverse
+     * @throws std::invalid_argument if the value and the modulus aren't coprime
+     */
+    modint inverse() const
+    {
+        __int128 t0 = 0, t1 = 1;
+        uint64_t r0 = Modulus, r1 = value();
+        while (r1 != 0)
+        {
+            uint64_t q = r0 / r1;
+            std::swap(r0, r1);
+            r1 -= q * r0;
+            std::swap(t0, t1);
+            t1 -= static_cast<__int128>(q) * t0;
+        }
+        if (r0 != 1)
+            throw std::invalid_argument("Inverse does not exist");
+        if (t0 < 0)
+            t0 += Modulus;
+        return modint(static_cast<uint64_t>(t0), false);
+    }
+
+    /**
+     * @brief Returns the value as an integer in [0, Modulus).
+     *
+     * @return uint64_t The value
+     */
+    uint64_t value() const
+    {
+        return montgomery ? reduce(v) : v;
+    }
+
+    /**
+     * @brief Converts the value to a bigint.
+     *
+     * @return bigint The value in [0, Modulus)
+     */
+    bigint to_bigint() const
+    {
+        return bigint(std::to_string(value()));
+    }
+
+    /**
+     * @brief Returns the modulus.
+     *
+     * @return uint64_t The modulus
+     */
+    static constexpr uint64_t modulus()
+    {
+        return Modulus;
+    }
+
+    /**
+     * @brief Construct a new modint object with an initial value of 0.
+     *
+     */
+    modint() : v(0) {}
+
+    /**
+     * @brief Construct a new modint object from a signed 64-bit integer.
+     *
+     * @param value The integer, reduced into [0, Modulus)
+     */
+    modint(int64_t value) : v(0)
+    {
+        uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        uint64_t residue = magnitude % Modulus;
+        if (value < 0 && residue != 0)
+            residue = Modulus - residue;
+        v = to_form(residue);
+    }
+
+    /**
+     * @brief Construct a new modint object from a bigint.
+     *
+     * The digits are folded in chunks of 18, so only one division runs per chunk.
+     *
+     * @param value The integer, reduced into [0, Modulus)
+     */
+    modint(const bigint &value) : v(0)
+    {
+        uint64_t residue = 0;
+        size_t i = value.digits();
+        while (i > 0)
+        {
+            size_t length = i % 18 == 0 ? 18 : i % 18;
+            uint64_t chunk = 0;
+            uint64_t scale = 1;
+            for (size_t j = 0; j < length; ++j, --i)
+            {
+                chunk = chunk * 10 + value.digit(i - 1);
+                scale *= 10;
+            }
+            residue = static_cast<uint64_t>((static_cast<uint128>(residue) * scale + chunk) % Modulus);
+        }
+        if (value < 0 && residue != 0)
+            residue = Modulus - residue;
+        v = to_form(residue);
+    }
+
+private:
+    using uint128 = unsigned __int128;
+
+    /**
+     * @brief The value, in Montgomery form if the modulus allows it.
+     *
+     */
+    uint64_t v;
+
+    /**
+     * @brief Whether the values are kept in Montgomery form.
+     *
+     * The bound keeps `T + m * Modulus` within 128 bits in reduce().
+     *
+     */
+    static constexpr bool montgomery = Modulus % 2 == 1 && Modulus < (uint64_t(1) << 63);
+
+    /**
+     * @brief Computes -Modulus^-1 mod 2^64 by Newton iteration.
+     *
+     * An odd number is its own inverse modulo 8, and every step doubles the number
+     * of correct bits.
+     *
+     * @return uint64_t The negated inverse
+     */
+    static constexpr uint64_t negated_inverse()
+    {
+        uint64_t inverse = Modulus;
+        for (int i = 0; i < 5; ++i)
+            inverse *= 2 - Modulus * inverse;
+        return 0 - inverse;
+    }
+
+    /**
+     * @brief -Modulus^-1 mod 2^64, used by reduce().
+     *
+     */
+    static constexpr uint64_t n_prime = montgomery ? negated_inverse() : 0;
+
+    /**
+     * @brief 2^128 mod Modulus, used to convert into Montgomery form.
+     *
+     */
+    static constexpr uint64_t r2 = static_cast<uint64_t>(static_cast<uint128>((0 - Modulus) % Modulus) * ((0 - Modulus) % Modulus) % Modulus);
+
+    /**
+     * @brief Construct a new modint object from a value in [0, Modulus).
+     *
+     * @param value The value
+     * @param form true if the value is already in internal form
+     */
+    modint(uint64_t value, bool form) : v(form ? value : to_form(value)) {}
+
+    /**
+     * @brief Wraps a value that is already in internal form.
+     *
+     * @param form The internal value
+     * @return modint The modint holding it
+     */
+    static modint from_form(uint64_t form)
+    {
+        return modint(form, true);
+    }
+
+    /**
+     * @brief Montgomery reduction: computes t * 2^-64 mod Modulus for t < Modulus * 2^64.
+     *
+     * @param t The value to reduce
+     * @return uint64_t The reduced value in [0, Modulus)
+     */
+    static uint64_t reduce(uint128 t)
+    {
+        uint64_t m = static_cast<uint64_t>(t) * n_prime;
+        uint64_t u = static_cast<uint64_t>((t + static_cast<uint128>(m) * Modulus) >> 64);
+        return u >= Modulus ? u - Modulus : u;
+    }
+
+    /**
+     * @brief Multiplies two values in internal form.
+     *
+     * @param a The first value
+     * @param b The second value
+     * @return uint64_t The product in internal form
+     */
+    static uint64_t multiply(uint64_t a, uint64_t b)
+    {
+        if constexpr (montgomery)
+            return reduce(static_cast<uint128>(a) * b);
+        else
+            return static_cast<uint64_t>(static_cast<uint128>(a) * b % Modulus);
+    }
+
+    /**
+     * @brief Converts a value in [0, Modulus) into internal form.
+     *
+     * @param a The value
+     * @return uint64_t The internal form
+     */
+    static uint64_t to_form(uint64_t a)
+    {
+        return montgomery ? reduce(static_cast<uint128>(a) * r2) : a;
+    }
+};
+
+/**
+ * @brief The precomputed constants for arithmetic modulo a runtime bigint modulus
+ *
+ * Montgomery reduction normally uses a power of two for R. bigint stores decimal
+ * digits, so here R = 10^k with k the digit count of the modulus: the reduction
+ * then only takes the low k digits and drops them, and never divides. This needs
+ * a modulus coprime to 10; for a multiple of 2 or 5 the context falls back to `%`.
+ *
+ */
+class montgomery_context
+{
+public:
+    /**
+     * @brief Returns the modulus.
+     *
+     * @return const bigint& The modulus
+     */
+    const bigint &modulus() const
+    {
+        return n;
+    }
+
+    /**
+     * @brief Tells whether values are kept in Montgomery form.
+     *
+     * @return true if the modulus is coprime to 10
+     * @return false if the context reduces with `%`
+     */
+    bool uses_montgomery() const
+    {
+        return montgomery;
+    }
+
+    /**
+     * @brief Converts an integer into internal form.
+     *
+     * @param a Any integer
+     * @return bigint The internal form of a mod n
+     */
+    bigint to_form(const bigint &a) const
+    {
+        bigint residue = a % n;
+        if (residue < 0)
+            residue += n;
+        return montgomery ? reduce(residue * r2) : residue;
+    }
+
+    /**
+     * @brief Converts a value in internal form back into [0, n).
+     *
+     * @param a The internal form
+     * @return bigint The value
+     */
+    bigint from_form(const bigint &a) const
+    {
+        return montgomery ? reduce(a) : a;
+    }
+
+    /**
+     * @brief Returns the internal form of 1.
+     *
+     * @return const bigint& R mod n, or 1 without Montgomery form
+     */
+    const bigint &one() const
+    {
+        return r1;
+    }
+
+    /**
+     * @brief Adds two values in internal form.
+     *
+     * @param a The first value
+     * @param b The second value
+     * @return bigint The sum in internal form
+     */
+    bigint add(const bigint &a, const bigint &b) const
+    {
+        bigint sum = a + b;
+        if (sum >= n)
+            sum -= n;
+        return sum;
+    }
+
+    /**
+     * @brief Subtracts two values in internal form.
+     *
+     * @param a The minuend
+     * @param b The subtrahend
+     * @return bigint The difference in internal form
+     */
+    bigint subtract(const bigint &a, const bigint &b) const
+    {
+        bigint difference = a - b;
+        if (difference < 0)
+            difference += n;
+        return difference;
+    }
+
+    /**
+     * @brief Multiplies two values in internal form.
+     *
+     * @param a The first value
+     * @param b The second value
+     * @return bigint The product in internal form
+     */
+    bigint multiply(const bigint &a, const bigint &b) const
+    {
+        return montgomery ? reduce(a * b) : (a * b) % n;
+    }
+
+    /**
+     * @brief Construct a new montgomery_context object.
+     *
+     * Computing R^2 mod n is the only division by the modulus.
+     *
+     * @param modulus The modulus, greater than 1
+     * @throws std::invalid_argument if the modulus is not greater than 1
+     */
+    montgomery_context(const bigint &modulus) : n(modulus), k(modulus.digits()), n_prime(0), r1(1), r2(0), montgomery(false)
+    {
+        if (modulus <= 1)
+            throw std::invalid_argument("Modulus must be greater than 1");
+
+        uint8_t last = modulus.digit(0);
+        montgomery = last == 1 || last == 3 || last == 7 || last == 9;
+        if (!montgomery)
+            return;
+
+        // Newton iteration for n^-1 mod 10^k, doubling the correct digits each step
+        bigint inverse(last == 3 ? 7 : last == 7 ? 3 : last);
+        for (size_t p = 1; p < k;)
+        {
+            p = std::min(2 * p, k);
+            bigint error = (n.low_digits(p) * inverse).low_digits(p);
+            inverse = (inverse * (bigint(2) - error)).low_digits(p);
+            if (inverse < 0)
+                inverse += bigint(1).shift10(static_cast<int64_t>(p));
+        }
+        n_prime = bigint(1).shift10(static_cast<int64_t>(k)) - inverse;
+
+        r1 = bigint(1).shift10(static_cast<int64_t>(k)) % n;
+        r2 = bigint(1).shift10(static_cast<int64_t>(2 * k)) % n;
+    }
+
+private:
+    /**
+     * @brief The modulus.
+     *
+     */
+    bigint n;
+
+    /**
+     * @brief The digit count of the modulus, so R = 10^k > n.
+     *
+     */
+    size_t k;
+
+    /**
+     * @brief -n^-1 mod R.
+     *
+     */
+    bigint n_prime;
+
+    /**
+     * @brief R mod n, the internal form of 1.
+     *
+     */
+    bigint r1;
+
+    /**
+     * @brief R^2 mod n, used to convert into Montgomery form.
+     *
+     */
+    bigint r2;
+
+    /**
+     * @brief Whether values are kept in Montgomery form.
+     *
+     */
+    bool montgomery;
+
+    /**
+     * @brief Montgomery reduction: computes t * R^-1 mod n for 0 <= t < n * R.
+     *
+     * `t + m * n` is a multiple of R, so the division by R drops k zero digits.
+     *
+     * @param t The value to reduce
+     * @return bigint The reduced value in [0, n)
+     */
+    bigint reduce(const bigint &t) const
+    {
+        bigint m = (t.low_digits(k) * n_prime).low_digits(k);
+        bigint u = (t + m * n).shift10(-static_cast<int64_t>(k));
+        if (u >= n)
+            u -= n;
+        return u;
+    }
+};
+
+/**
+ * @brief A class for integers modulo a runtime bigint modulus
+ *
+ * Values share a montgomery_context and stay in its internal form, so `+`, `-`,
+ * `*` and pow() never divide by the modulus; only the construction from an
+ * integer and value() convert. inverse(), and so `/`, runs the extended
+ * Euclidean algorithm with bigint long division and converts the result back.
+ *
+ */
+class dyn_modint
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * @param out an instance of std::ostream
+     * @param num the dyn_modint object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const dyn_modint &num)
+    {
+        return out << num.value();
+    }
+
+public:
+    /**
+     * @brief Checks if two dyn_modint numbers are equal
+     *
+     * @param rhs The dyn_modint to compare with
+     * @return true if both dyn_modint numbers are equal
+     * @return false otherwise
+     */
+    bool operator==(const dyn_modint &rhs) const
+    {
+        check_context(rhs);
+        return v == rhs.v;
+    }
+
+    /**
+     * @brief Check if two dyn_modint numbers are not equal
+     *
+     * @param rhs The dyn_modint to compare with
+     * @return true if the dyn_modint numbers are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const dyn_modint &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Adds two dyn_modint numbers
+     *
+     * @param rhs The dyn_modint to add to the current dyn_modint
+     * @return dyn_modint A new one representing the sum
+     */
+    dyn_modint operator+(const dyn_modint &rhs) const
+    {
+        check_context(rhs);
+        return dyn_modint(ctx, ctx->add(v, rhs.v));
+    }
+
+    /**
+     * @brief Subtracts the given dyn_modint from the current dyn_modint
+     *
+     * @param rhs The dyn_modint to subtract
+     * @return dyn_modint A new one representing the difference
+     */
+    dyn_modint operator-(const dyn_modint &rhs) const
+    {
+        check_context(rhs);
+        return dyn_modint(ctx, ctx->subtract(v, rhs.v));
+    }
+
+    /**
+     * @brief Multiplies two dyn_modint numbers
+     *
+     * @param rhs The dyn_modint to multiply with the current dyn_modint
+     * @return dyn_modint A new one representing the product
+     */
+    dyn_modint operator*(const dyn_modint &rhs) const
+    {
+        check_context(rhs);
+        return dyn_modint(ctx, ctx->multiply(v, rhs.v));
+    }
+
+    /**
+     * @brief Divides the current dyn_modint by the given dyn_modint
+     *
+     * @param rhs The dyn_modint divisor, which must be invertible
+     * @return dyn_modint A new one representing the quotient
+     */
+    dyn_modint operator/(const dyn_modint &rhs) const
+    {
+        return *this * rhs.inverse();
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return dyn_modint& A reference to the current object after the operation
+     */
+    dyn_modint &operator+=(const dyn_modint &rhs)
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return dyn_modint& A reference to the current object after the operation
+     */
+    dyn_modint &operator-=(const dyn_modint &rhs)
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return dyn_modint& A reference to the current object after the operation
+     */
+    dyn_modint &operator*=(const dyn_modint &rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment /= overloading
+     *
+     * @param rhs right hand side
+     * @return dyn_modint& A reference to the current object after the operation
+     */
+    dyn_modint &operator/=(const dyn_modint &rhs)
+    {
+        *this = *this / rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return dyn_modint A negated dyn_modint value
+     */
+    dyn_modint operator-() const
+    {
+        return dyn_modint(ctx, ctx->subtract(bigint(0), v));
+    }
+
+    /**
+     * @brief Raises the dyn_modint to a power.
+     *
+     * The exponent is scanned one decimal digit at a time: the running result is
+     * raised to the 10th power with four multiplications and multiplied by a
+     * precomputed power for the digit.
+     *
+     * @param exponent The exponent; a negative one raises the inverse
+     * @return dyn_modint The power, with 0^0 = 1
+     */
+    dyn_modint pow(const bigint &exponent) const
+    {
+        if (exponent < 0)
+            return inverse().pow(-exponent);
+
+        std::vector<bigint> powers(10, ctx->one());
+        for (size_t d = 1; d < powers.size(); ++d)
+            powers[d] = ctx->multiply(powers[d - 1], v);
+
+        bigint result = ctx->one();
+        for (size_t i = exponent.digits(); i > 0; --i)
+        {
+            bigint square = ctx->multiply(result, result);
+            bigint fifth = ctx->multiply(ctx->multiply(square, square), result);
+            result = ctx->multiply(fifth, fifth);
+            uint8_t d = exponent.digit(i - 1);
+            if (d != 0)
+                result = ctx->multiply(result, powers[d]);
+        }
+        return dyn_modint(ctx, result);
+    }
+
+    /**
+     * @brief Computes the multiplicative inverse with the extended Euclidean algorithm.
+     *
+     * @return dyn_modint The inverse
+     * @throws std::invalid_argument if the value and the modulus aren't coprime
+     */
+    dyn_modint inverse() const
+    {
+        bigint t0(0), t1(1);
+        bigint r0 = ctx->modulus(), r1 = value();
+        while (r1 != 0)
+        {
+            bigint q = r0 / r1;
+            r0 = std::exchange(r1, r0 - q * r1);
+            t0 = std::exchange(t1, t0 - q * t1);
+        }
+        if (r0 != 1)
+            throw std::invalid_argument("Inverse does not exist");
+        return dyn_modint(t0, ctx);
+    }
+
+    /**
+     * @brief Returns the value as an integer in [0, modulus).
+     *
+     * @return bigint The value
+     */
+    bigint value() const
+    {
+        return ctx->from_form(v);
+    }
+
+    /**
+     * @brief Returns the shared context holding the modulus.
+     *
+     * @return const std::shared_ptr<const montgomery_context>& The context
+     */
+    const std::shared_ptr<const montgomery_context> &context() const
+    {
+        return ctx;
+    }
+
+    /**
+     * @brief Construct a new dyn_modint object from an integer and a context.
+     *
+     * @param value The integer, reduced into [0, modulus)
+     * @param context The context for the modulus
+     */
+    dyn_modint(const bigint &value, std::shared_ptr<const montgomery_context> context) : v(context->to_form(value)), ctx(std::move(context)) {}
+
+private:
+    /**
+     * @brief The value in the internal form of the context.
+     *
+     */
+    bigint v;
+
+    /**
+     * @brief The context holding the modulus.
+     *
+     */
+    std::shared_ptr<const montgomery_context> ctx;
+
+    /**
+     * @brief Construct a new dyn_modint object from a value already in internal form.
+     *
+     * @param context The context for the modulus
+     * @param form The internal form
+     */
+    dyn_modint(std::shared_ptr<const montgomery_context> context, bigint form) : v(std::move(form)), ctx(std::move(context)) {}
+
+    /**
+     * @brief Checks that both operands use the same modulus.
+     *
+     * @param rhs The other operand
+     * @throws std::invalid_argument if the moduli differ
+     */
+    void check_context(const dyn_modint &rhs) const
+    {
+        if (ctx != rhs.ctx && ctx->modulus() != rhs.ctx->modulus())
+            throw std::invalid_argument("Mismatched moduli");
+    }
+};
+
+#endif // MODINT_HPP
@@ -0,0 +1,449 @@
+/**
+ * @file shared_bigint.hpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A file that contains the class shared_bigint
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef SHARED_BIGINT_HPP
+#define SHARED_BIGINT_HPP
+
+#include "bigint.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+/**
+ * @brief A bigint with shared, copy-on-write storage
+ *
+ * Copies share one bigint through an atomically reference counted pointer, so
+ * passing, returning and storing a shared_bigint is O(1) whatever the number of
+ * digits. A mutation copies the digits first only if they are shared; a value
+ * that isn't shared is updated in place.
+ *
+ * As with std::shared_ptr, distinct shared_bigint objects can be used from
+ * different threads even when they share storage, but one shared_bigint can't
+ * be mutated while another thread reads it.
+ *
+ */
+class shared_bigint
+{
+    /**
+     * @brief I/O operator for insertion overloading
+     *
+     * @param out an instance of std::ostream
+     * @param num the shared_bigint object whose value will be output
+     * @return std::ostream& A reference to the same output stream that's passed as an argument
+     */
+    friend std::ostream &operator<<(std::ostream &out, const shared_bigint &num)
+    {
+        return out << *num.ptr;
+    }
+
+public:
+    /**
+     * @brief Checks if two shared_bigint numbers are equal
+     *
+     * Values sharing storage are equal without comparing digits.
+     *
+     * @param rhs The shared_bigint to compare with
+     * @return true if both numbers are equal
+     * @return false otherwise
+     */
+    bool operator==(const shared_bigint &rhs) const
+    {
+        return ptr == rhs.ptr || *ptr == *rhs.ptr;
+    }
+
+    /**
+     * @brief Check if two shared_bigint numbers are not equal
+     *
+     * @param rhs The shared_bigint to compare with
+     * @return true if the numbers are not equal
+     * @return false otherwise
+     */
+    bool operator!=(const shared_bigint &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Compares if the current number is less than the given one
+     *
+     * @param rhs The shared_bigint to compare with
+     * @return true if the current number is less than the given one
+     * @return false otherwise
+     */
+    bool operator<(const shared_bigint &rhs) const
+    {
+        return *ptr < *rhs.ptr;
+    }
+
+    /**
+     * @brief Compares if the current number is less than or equal to the given one
+     *
+     * @param rhs The shared_bigint to compare with
+     * @return true if the current number is less than or equal to the given one
+     * @return false otherwise
+     */
+    bool operator<=(const shared_bigint &rhs) const
+    {
+        return !(rhs < *this);
+    }
+
+    /**
+     * @brief Compares if the current number is greater than the given one
+     *
+     * @param rhs The shared_bigint to compare with
+     * @return true if the current number is greater than the given one
+     * @return false otherwise
+     */
+    bool operator>(const shared_bigint &rhs) const
+    {
+        return rhs < *this;
+    }
+
+    /**
+     * @brief Compares if the current number is greater than or equal to the given one
+     *
+     * @param rhs The shared_bigint to compare with
+     * @return true if the current number is greater than or equal to the given one
+     * @return false otherwise
+     */
+    bool operator>=(const shared_bigint &rhs) const
+    {
+        return !(*this < rhs);
+    }
+
+    /**
+     * @brief Adds two numbers
+     *
+     * @param rhs The shared_bigint to add to the current one
+     * @return shared_bigint A new one representing the sum
+     */
+    shared_bigint operator+(const shared_bigint &rhs) const
+    {
+        return shared_bigint(*ptr + *rhs.ptr);
+    }
+
+    /**
+     * @brief Subtracts the given number from the current one
+     *
+     * @param rhs The shared_bigint to subtract
+     * @return shared_bigint A new one representing the difference
+     */
+    shared_bigint operator-(const shared_bigint &rhs) const
+    {
+        return shared_bigint(*ptr - *rhs.ptr);
+    }
+
+    /**
+     * @brief Multiplies two numbers
+     *
+     * @param rhs The shared_bigint to multiply with the current one
+     * @return shared_bigint A new one representing the product
+     */
+    shared_bigint operator*(const shared_bigint &rhs) const
+    {
+        return shared_bigint(*ptr * *rhs.ptr);
+    }
+
+    /**
+     * @brief Divides the current number by the given one, truncating toward zero
+     *
+     * @param rhs The shared_bigint divisor
+     * @return shared_bigint A new one representing the quotient
+     */
+    shared_bigint operator/(const shared_bigint &rhs) const
+    {
+        return shared_bigint(*ptr / *rhs.ptr);
+    }
+
+    /**
+     * @brief Computes the remainder of the current number divided by the given one
+     *
+     * @param rhs The shared_bigint divisor
+     * @return shared_bigint A new one representing the remainder
+     */
+    shared_bigint operator%(const shared_bigint &rhs) const
+    {
+        return shared_bigint(*ptr % *rhs.ptr);
+    }
+
+    /**
+     * @brief compound assignment += overloading
+     *
+     * @param rhs right hand side
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &operator+=(const shared_bigint &rhs)
+    {
+        // Read rhs before detaching, in case it shares the storage of *this
+        bigint sum = *ptr + *rhs.ptr;
+        mutate() = std::move(sum);
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment -= overloading
+     *
+     * @param rhs right hand side
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &operator-=(const shared_bigint &rhs)
+    {
+        bigint difference = *ptr - *rhs.ptr;
+        mutate() = std::move(difference);
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment *= overloading
+     *
+     * @param rhs right hand side
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &operator*=(const shared_bigint &rhs)
+    {
+        bigint product = *ptr * *rhs.ptr;
+        mutate() = std::move(product);
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment /= overloading
+     *
+     * @param rhs right hand side
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &operator/=(const shared_bigint &rhs)
+    {
+        bigint quotient = *ptr / *rhs.ptr;
+        mutate() = std::move(quotient);
+        return *this;
+    }
+
+    /**
+     * @brief compound assignment %= overloading
+     *
+     * @param rhs right hand side
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &operator%=(const shared_bigint &rhs)
+    {
+        bigint remainder = *ptr % *rhs.ptr;
+        mutate() = std::move(remainder);
+        return *this;
+    }
+
+    /**
+     * @brief Adds the product of two numbers to the current one, in place if it isn't shared.
+     *
+     * @param a The first factor
+     * @param b The second factor
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &addmul(const shared_bigint &a, const shared_bigint &b)
+    {
+        if (ptr == a.ptr || ptr == b.ptr)
+        {
+            bigint sum = *ptr + *a.ptr * *b.ptr;
+            mutate() = std::move(sum);
+        }
+        else
+            mutate().addmul(*a.ptr, *b.ptr);
+        return *this;
+    }
+
+    /**
+     * @brief Unary operator - overloading
+     *
+     * @return shared_bigint A negated value
+     */
+    shared_bigint operator-() const
+    {
+        return shared_bigint(-*ptr);
+    }
+
+    /**
+     * @brief Returns the value.
+     *
+     * @return const bigint& The value, valid until the current object is mutated or destroyed
+     */
+    const bigint &value() const
+    {
+        return *ptr;
+    }
+
+    /**
+     * @brief Returns the value.
+     *
+     * @return const bigint& The value, valid until the current object is mutated or destroyed
+     */
+    const bigint &operator*() const
+    {
+        return *ptr;
+    }
+
+    /**
+     * @brief Accesses the members of the value.
+     *
+     * @return const bigint* The value, valid until the current object is mutated or destroyed
+     */
+    const bigint *operator->() const
+    {
+        return ptr.get();
+    }
+
+    /**
+     * @brief Converts to the value, so a shared_bigint can be passed where a const bigint& is expected.
+     *
+     * @return const bigint& The value
+     */
+    operator const bigint &() const
+    {
+        return *ptr;
+    }
+
+    /**
+     * @brief Returns the number of shared_bigint objects sharing the storage.
+     *
+     * @return long The number of objects
+     */
+    long use_count() const
+    {
+        return ptr.use_count();
+    }
+
+    /**
+     * @brief Gives mutable access to the value, copying the digits first if they are shared.
+     *
+     * @return bigint& The value, owned by the current object alone
+     */
+    bigint &mutate()
+    {
+        if (ptr.use_count() == 1)
+        {
+            // use_count() is a relaxed load; the fence orders the writes that follow
+            // after the last reads of a thread that just released its copy
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return *ptr;
+        }
+        ptr = std::make_shared<bigint>(*ptr);
+        return *ptr;
+    }
+
+    /**
+     * @brief Construct a new shared_bigint object with an initial value of 0.
+     *
+     * Every default-constructed object shares one zero, so this doesn't allocate.
+     *
+     */
+    shared_bigint() : ptr(shared_zero()) {}
+
+    /**
+     * @brief Construct a new shared_bigint object from a bigint.
+     *
+     * @param value The value, moved into the shared storage
+     */
+    shared_bigint(bigint value) : ptr(std::make_shared<bigint>(std::move(value))) {}
+
+    /**
+     * @brief Construct a new shared_bigint object from a signed 64-bit integer.
+     *
+     * @param num The signed 64-bit integer
+     */
+    shared_bigint(int64_t num) : ptr(std::make_shared<bigint>(num)) {}
+
+    /**
+     * @brief Construct a new shared_bigint object from a decimal string.
+     *
+     * @param str The decimal string, as accepted by bigint(const std::string &)
+     */
+    explicit shared_bigint(const std::string &str) : ptr(std::make_shared<bigint>(str)) {}
+
+    /**
+     * @brief Construct a new shared_bigint object sharing the storage of another.
+     *
+     * @param other The shared_bigint to copy
+     */
+    shared_bigint(const shared_bigint &other) = default;
+
+    /**
+     * @brief Construct a new shared_bigint object taking the storage of another.
+     *
+     * The source is left holding the shared zero, so it stays usable.
+     *
+     * @param other The shared_bigint to move from
+     */
+    shared_bigint(shared_bigint &&other) noexcept : ptr(std::move(other.ptr))
+    {
+        other.ptr = shared_zero();
+    }
+
+    /**
+     * @brief Makes the object share the storage of another.
+     *
+     * @param other The shared_bigint to copy
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &operator=(const shared_bigint &other) = default;
+
+    /**
+     * @brief Makes the object take the storage of another.
+     *
+     * The pointers are swapped, so the source is left holding the previous value.
+     *
+     * @param other The shared_bigint to move from
+     * @return shared_bigint& A reference to the current object after the operation
+     */
+    shared_bigint &operator=(shared_bigint &&other) noexcept
+    {
+        ptr.swap(other.ptr);
+        return *this;
+    }
+
+private:
+    /**
+     * @brief The shared value; never null, even in a moved-from object.
+     *
+     */
+    std::shared_ptr<bigint> ptr;
+
+    /**
+     * @brief Returns the zero shared by default-constructed objects.
+     *
+     * @return const std::shared_ptr<bigint>& The shared zero
+     */
+    static const std::shared_ptr<bigint> &shared_zero()
+    {
+        static const std::shared_ptr<bigint> zero = std::make_shared<bigint>(0);
+        return zero;
+    }
+};
+
+namespace std
+{
+    /**
+     * @brief Hashes shared_bigint values like the bigint they hold.
+     *
+     */
+    template <>
+    struct hash<shared_bigint>
+    {
+        size_t operator()(const shared_bigint &value) const
+        {
+            return value->hash();
+        }
+    };
+}
+
+#endif // SHARED_BIGINT_HPP
@@ -9,10 +9,43 @@
  *
  */
 #include "bigint.hpp"
+#include "bigint_accumulator.hpp"
+#include "bigint_arena.hpp"
+#include "bigint_expr.hpp"
+#include "bigint_file.hpp"
+#include "bigint_matrix.hpp"
+#include "bigint_memo.hpp"
+#include "bigint_parser.hpp"
+#include "bigint_pool.hpp"
+#include "bigint_scan.hpp"
+#include "bigint_sort.hpp"
+#include "bigint_threads.hpp"
+#include "bigint_poly.hpp"
+#include "bigdecimal.hpp"
+#include "bigfloat.hpp"
+#include "disk_bigint.hpp"
+#include "bigrational.hpp"
+#include "hashed_bigint.hpp"
+#include "modint.hpp"
+#include "shared_bigint.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <random>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 /**
  * @brief Tests the default constructor of the `bigint` class.
  *
@@ -441,7 +474,8 @@ void test_subtraction()
  * @brief Test the multiplication operator for the `bigint` class.
  *
  * This function verifies the correctness of multiplication with edge cases,
- * including positive numbers, negative numbers, zero, and large numbers.
+ * including positive numbers, negative numbers, zero, and large numbers, and
+ * the Karatsuba path on balanced and unbalanced operands, and addmul().
  *
  */
 void test_multiplication()
@@ -463,6 +497,24 @@ void test_multiplication()
     if (!(d * e == bigint("121932631112635269")))
         throw std::invalid_argument("Fail: Multiplication of large numbers.");
 
+    // Operands past the Karatsuba threshold, balanced and unbalanced, against the schoolbook product
+    size_t threshold = bigint::get_karatsuba_threshold();
+    bigint nines(std::string(150, '9'));
+    bigint f = nines * bigint("-31415926535897932384626433832795028841971");
+    bigint::set_karatsuba_threshold(2);
+    bool karatsuba_ok = nines * nines == bigint(std::string(149, '9') + "8" + std::string(149, '0') + "1") &&
+                        nines * bigint("-31415926535897932384626433832795028841971") == f && f * nines * bigint(0) == 0;
+    bigint::set_karatsuba_threshold(threshold);
+    if (!karatsuba_ok)
+        throw std::invalid_argument("Fail: Karatsuba multiplication.");
+
+    bigint acc(7);
+    acc.addmul(bigint(-3), bigint(4)).addmul(bigint(2), bigint(5)).addmul(bigint(0), nines);
+    bigint big_acc(-1);
+    big_acc.addmul(nines, nines);
+    if (!(acc == 5 && big_acc == nines * nines - 1 && bigint(-100).addmul(bigint(-10), bigint(10)) == -200 && bigint(-100).addmul(bigint(-10), bigint(-10)) == 0))
+        throw std::invalid_argument("Fail: Fused multiply-add.");
+
     std::cout << "Pass.\n";
 }
 
@@ -815,6 +867,353 @@ void test_to_string()
     }
 }
 
+/**
+ * @brief Tests memory_usage(), shrink_to_fit() and the shrink policy of the bigint class.
+ *
+ * This test checks that the reported memory covers at least the stored digits,
+ * that shrinking never changes the value, and that the `always` policy leaves
+ * no unused capacity behind arithmetic results.
+ *
+ */
+void test_memory_usage()
+{
+    try
+    {
+        std::cout << "Testing memory_usage() and shrink policy: ";
+
+        bigint num("123456789123456789123456789");
+        if (num.memory_usage() < sizeof(bigint) + 27)
+            throw std::invalid_argument("Fail: memory_usage() should cover all digits.");
+
+        bigint sum = num + num;
+        size_t before = sum.memory_usage();
+        sum.shrink_to_fit();
+        if (sum.memory_usage() > before || sum != bigint("246913578246913578246913578"))
+            throw std::invalid_argument("Fail: shrink_to_fit() should keep the value.");
+
+        bigint::shrink_policy saved = bigint::get_shrink_policy();
+        bigint::set_shrink_policy(bigint::shrink_policy::always);
+        bigint diff = bigint("100000000000000000000") - bigint(1);
+        bigint::set_shrink_policy(saved);
+        if (diff.memory_usage() != sizeof(bigint) + 20 || diff != bigint("99999999999999999999"))
+            throw std::invalid_argument("Fail: shrink policy always should leave no slack.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief A random bit generator producing 1, 2, 3, ..., for checking conversions.
+ *
+ */
+struct sequence_engine
+{
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type next = 0;
+    result_type operator()() { return ++next; }
+};
+
+/**
+ * @brief Tests the random generation of the `bigint` class.
+ *
+ * This test checks the ranges of `random_digits`, `random_bits`, `random_below`
+ * and `fill_random`, the conversion of 64-bit draws to digits with a known
+ * sequence, and that `counter_engine` gives the same values one at a time and
+ * in blocks.
+ *
+ */
+void test_random()
+{
+    try
+    {
+        std::cout << "Testing random generation: ";
+
+        // An engine producing 1, 2, 3, ... makes the conversion checkable
+        sequence_engine seq;
+        bigint two64("18446744073709551616");
+        if (bigint::random_bits(192, seq) != bigint(1) + bigint(2) * two64 + bigint(3) * two64 * two64 || bigint::random_bits(60, seq) != bigint(4) || bigint::random_bits(0, seq) != bigint(0))
+            throw std::invalid_argument("Fail: Conversion of random bits.");
+
+        bigint::counter_engine engine(7), block_engine(7);
+        uint64_t block[5];
+        block_engine.generate(block, 5);
+        for (uint64_t value : block)
+            if (engine() != value)
+                throw std::invalid_argument("Fail: Counter engine blocks.");
+        engine.discard(3);
+        block_engine.generate(block, 4);
+        if (engine() != block[3])
+            throw std::invalid_argument("Fail: Counter engine discard.");
+
+        std::mt19937_64 rng(2024);
+        bigint ten30 = bigint(1).shift10(30), two200(1);
+        for (int i = 0; i < 200; ++i)
+            two200 *= bigint(2);
+        for (int i = 0; i < 50; ++i)
+        {
+            bigint d = bigint::random_digits(30, rng), b = bigint::random_bits(200, engine);
+            if (d < bigint(0) || d >= ten30 || b < bigint(0) || b >= two200)
+                throw std::invalid_argument("Fail: Range of random values.");
+        }
+
+        int counts[7] = {};
+        for (int i = 0; i < 7000; ++i)
+        {
+            bigint r = bigint::random_below(bigint(7), engine);
+            if (r < bigint(0) || r >= bigint(7))
+                throw std::invalid_argument("Fail: Range of bounded values.");
+            ++counts[std::stoi(r.to_string(10))];
+        }
+        for (int count : counts)
+            if (count < 800 || count > 1200)
+                throw std::invalid_argument("Fail: Distribution of bounded values.");
+        bigint bound = ten30 + bigint(1);
+        for (int i = 0; i < 50; ++i)
+        {
+            bigint r = bigint::random_below(bound, rng);
+            if (r < bigint(0) || r >= bound)
+                throw std::invalid_argument("Fail: Range of bounded values.");
+        }
+
+        std::vector<bigint> values(100, bigint(-123));
+        bigint::fill_random(values.begin(), values.end(), 25, engine);
+        bigint ten25 = bigint(1).shift10(25);
+        for (size_t i = 0; i < values.size(); ++i)
+            if (values[i] < bigint(0) || values[i] >= ten25 || (i > 0 && values[i] == values[0]))
+                throw std::invalid_argument("Fail: Bulk fill.");
+
+        try
+        {
+            bigint r = bigint::random_below(bigint(0), rng);
+            throw std::invalid_argument("Fail: Non-positive bound.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Bound must be positive")
+                throw;
+        }
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the hashing of the `bigint` class and the `hashed_bigint` class.
+ *
+ * This test checks that equal values hash equally whatever their construction,
+ * that int64_t keys hash and compare like the matching bigint, that nearby and
+ * long values are spread over the hash values, and that the hash functors work
+ * as unordered container parameters.
+ *
+ */
+void test_hash()
+{
+    try
+    {
+        std::cout << "Testing hashing: ";
+
+        for (int64_t num : {int64_t(0), int64_t(7), int64_t(-7), int64_t(1234567890123456789), int64_t(-99999999999)})
+            if (bigint(num).hash() != bigint::hash(num) || std::hash<bigint>()(bigint(num)) != bigint::hash(num) || hashed_bigint(num).hash() != bigint::hash(num) || !bigint(num).equals(num) || bigint(num).equals(num + 1))
+                throw std::invalid_argument("Fail: Hash of int64_t values.");
+        if (bigint(-7).equals(7) || bigint(0).equals(-1) || !bigint(std::to_string(INT64_MIN)).equals(INT64_MIN))
+            throw std::invalid_argument("Fail: Comparison with int64_t values.");
+
+        // Equal values built differently, and long values taking every path of the hash
+        std::string digits(300, '0');
+        for (size_t i = 0; i < digits.size(); ++i)
+            digits[i] = static_cast<char>('1' + i % 9);
+        for (size_t length : {15, 16, 17, 63, 64, 65, 130, 300})
+        {
+            bigint a(digits.substr(0, length)), b = bigint("-" + digits.substr(0, length)) * bigint(-1);
+            if (a.hash() != b.hash() || a.hash() == (-a).hash() || a.hash() == (a + bigint(1)).hash() || a.hash() == a.shift10(1).hash())
+                throw std::invalid_argument("Fail: Hash of long values.");
+        }
+
+        std::unordered_set<size_t> hashes, buckets;
+        for (int64_t i = 0; i < 10000; ++i)
+        {
+            size_t h = bigint(i).hash();
+            hashes.insert(h);
+            buckets.insert(h % 1024);
+        }
+        if (hashes.size() != 10000 || buckets.size() != 1024)
+            throw std::invalid_argument("Fail: Spread of hash values.");
+
+        std::unordered_map<bigint, int> map;
+        std::unordered_set<hashed_bigint> set;
+        std::unordered_set<bigint, bigint_hash, bigint_equal> transparent;
+        for (int64_t i = -50; i < 50; ++i)
+        {
+            map[bigint(i) * bigint("1000000000000000000000")] = static_cast<int>(i);
+            set.insert(hashed_bigint(bigint(i)));
+            transparent.insert(bigint(i));
+        }
+        if (map.at(bigint(-3) * bigint("1000000000000000000000")) != -3 || set.count(hashed_bigint(int64_t(49))) != 1 || set.count(hashed_bigint(int64_t(50))) != 0 || transparent.count(bigint(-50)) != 1)
+            throw std::invalid_argument("Fail: Unordered containers.");
+        if (bigint_hash()(int64_t(-42)) != bigint_hash()(bigint(-42)) || bigint_hash()(hashed_bigint(int64_t(-42))) != bigint_hash()(int64_t(-42)) || !bigint_equal()(bigint(-42), int64_t(-42)) || !bigint_equal()(int64_t(5), hashed_bigint(int64_t(5))) || bigint_equal()(hashed_bigint(int64_t(5)), bigint(6)))
+            throw std::invalid_argument("Fail: Transparent functors.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the bigrational class.
+ *
+ * This test checks construction and reduction of fractions, the arithmetic and
+ * comparison operators (including the integer and cross-gcd paths), lazy
+ * reduction against the reduce bound, and division by zero.
+ *
+ */
+void test_bigrational()
+{
+    try
+    {
+        std::cout << "Testing bigrational: ";
+
+        bigrational half(1, 2);
+        bigrational third("1/3");
+        if ((half + third).to_string() != "5/6" || (half - third).to_string() != "1/6")
+            throw std::invalid_argument("Fail: 1/2 + 1/3 and 1/2 - 1/3.");
+
+        if ((bigrational(4, -6)).to_string() != "-2/3" || bigrational(6, 3) != 2)
+            throw std::invalid_argument("Fail: Fraction normalization.");
+
+        if ((bigrational("3/4") * bigrational("2/9")).to_string() != "1/6")
+            throw std::invalid_argument("Fail: Cross-gcd multiplication.");
+
+        if ((half / bigrational(-3, 4)).to_string() != "-2/3")
+            throw std::invalid_argument("Fail: Division.");
+
+        if (!(third < half) || !(half > third) || !(bigrational(-1, 2) < third) || bigrational(2, 4) != half)
+            throw std::invalid_argument("Fail: Comparison.");
+
+        if ((bigrational(7) + half).to_string() != "15/2" || !(bigrational(3) * bigrational(5)).is_integer())
+            throw std::invalid_argument("Fail: Integer fast paths.");
+
+        // Sum of 1/k for k = 1..30 with a small reduce bound, against the known value
+        size_t saved = bigrational::get_reduce_bound();
+        bigrational::set_reduce_bound(8);
+        bigrational harmonic;
+        for (int64_t k = 1; k <= 30; ++k)
+            harmonic += bigrational(1, k);
+        bigrational::set_reduce_bound(saved);
+        if (harmonic.numerator() != bigint("9304682830147") || harmonic.denominator() != bigint("2329089562800"))
+            throw std::invalid_argument("Fail: Lazy reduction.");
+
+        // Const reads reduce a copy, so threads can read one unreduced value
+        const bigrational shared(bigint(6), bigint(-4));
+        std::vector<std::string> reads(4);
+        std::vector<std::thread> readers;
+        for (size_t t = 0; t < reads.size(); ++t)
+            readers.emplace_back([&shared, &reads, t]
+                                 { reads[t] = shared.to_string() + " " + shared.numerator().to_string(10); });
+        for (std::thread &reader : readers)
+            reader.join();
+        if (std::count(reads.begin(), reads.end(), "-3/2 -3") != 4 || shared.is_integer())
+            throw std::invalid_argument("Fail: Concurrent const reads.");
+        bigrational copy = shared;
+        copy.canonicalize();
+        if (copy.to_string() != "-3/2" || copy != shared)
+            throw std::invalid_argument("Fail: Canonicalize.");
+
+        try
+        {
+            bigrational zero = half / bigrational(0);
+            throw std::invalid_argument("Fail: Division by zero.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Division by zero")
+                throw;
+        }
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the bigfloat class.
+ *
+ * This test checks parsing and printing, the arithmetic operators and square
+ * root against known values, every rounding mode including ties, additions of
+ * operands with far apart exponents, and invalid operations.
+ *
+ */
+void test_bigfloat()
+{
+    try
+    {
+        std::cout << "Testing bigfloat: ";
+
+        if (bigfloat("-0.00125").to_string() != "-1.25e-3" || bigfloat("12.5e2").to_string() != "1.25e3")
+            throw std::invalid_argument("Fail: Parsing and printing.");
+
+        if ((bigfloat(1, 20) / bigfloat(7, 20)).to_string() != "1.4285714285714285714e-1")
+            throw std::invalid_argument("Fail: Division.");
+
+        if (bigfloat::sqrt(bigfloat(2), 30).to_string() != "1.41421356237309504880168872421")
+            throw std::invalid_argument("Fail: Square root.");
+
+        if (bigfloat("1.5") * bigfloat("-2.25") != bigfloat("-3.375") || bigfloat("0.1") + bigfloat("0.2") != bigfloat("0.3"))
+            throw std::invalid_argument("Fail: Multiplication and addition.");
+
+        bigfloat::rounding_mode saved = bigfloat::get_rounding_mode();
+        bigfloat two_thirds = bigfloat::div(bigfloat(2), bigfloat(3), 5);
+        bigfloat::set_rounding_mode(bigfloat::rounding_mode::toward_zero);
+        bool zero_ok = bigfloat::div(bigfloat(-2), bigfloat(3), 5).to_string() == "-6.6666e-1";
+        bigfloat::set_rounding_mode(bigfloat::rounding_mode::toward_negative);
+        bool negative_ok = bigfloat::div(bigfloat(-2), bigfloat(3), 5).to_string() == "-6.6667e-1";
+        bigfloat::set_rounding_mode(bigfloat::rounding_mode::toward_positive);
+        bool positive_ok = bigfloat::add(bigfloat(1), bigfloat("1e-100"), 10).to_string() == "1.000000001";
+        bigfloat::set_rounding_mode(saved);
+        if (two_thirds.to_string() != "6.6667e-1" || !zero_ok || !negative_ok || !positive_ok)
+            throw std::invalid_argument("Fail: Rounding modes.");
+
+        // Ties go to the even digit
+        if (bigfloat("2.5", 1).to_string() != "2" || bigfloat("3.5", 1).to_string() != "4" || bigfloat("-9.5", 1).to_string() != "-1e1")
+            throw std::invalid_argument("Fail: Ties to even.");
+
+        if (bigfloat::add(bigfloat(1), bigfloat("-1e-100"), 10).to_string() != "1" || !(bigfloat("1e-100") < bigfloat("2e-100")))
+            throw std::invalid_argument("Fail: Far apart exponents.");
+
+        try
+        {
+            bigfloat root = bigfloat::sqrt(bigfloat(-1), 10);
+            throw std::invalid_argument("Fail: Square root of a negative number.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Square root of a negative number")
+                throw;
+        }
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
 /**
  * @brief Main function to execute all tests.
  *
@@ -823,6 +1222,1306 @@ void test_to_string()
  *
  * @return int Exit status.
  */
+/**
+ * @brief Tests the bigdecimal class.
+ *
+ * This test checks parsing and printing with trailing zeros, comparisons across
+ * scales, every rounding mode when rescaling and dividing, batch summation of
+ * mixed scales, and division by zero.
+ *
+ */
+void test_bigdecimal()
+{
+    try
+    {
+        std::cout << "Testing bigdecimal: ";
+
+        if (bigdecimal("-123.4500").to_string() != "-123.4500" || bigdecimal("-0.05").to_string() != "-0.05" || bigdecimal("42").scale() != 0)
+            throw std::invalid_argument("Fail: Parsing and printing.");
+
+        if ((bigdecimal("0.1") + bigdecimal("0.25")).to_string() != "0.35" || (bigdecimal("1.10") * bigdecimal("-2.5")).to_string() != "-2.750")
+            throw std::invalid_argument("Fail: Addition and multiplication.");
+
+        if (bigdecimal("1.5") != bigdecimal("1.50") || !(bigdecimal("-0.01") < bigdecimal("0")) || !(bigdecimal("2.001") > bigdecimal("2")))
+            throw std::invalid_argument("Fail: Comparisons across scales.");
+
+        // Ties go to the even digit, other modes round half up or truncate
+        using mode = bigdecimal::rounding_mode;
+        if (bigdecimal("2.345").rescale(2).to_string() != "2.34" || bigdecimal("2.355").rescale(2).to_string() != "2.36" ||
+            bigdecimal("-2.3451").rescale(2).to_string() != "-2.35" || bigdecimal("-0.5").rescale(0).to_string() != "0" ||
+            bigdecimal("2.345").rescale(2, mode::half_up).to_string() != "2.35" ||
+            bigdecimal("-2.349").rescale(2, mode::toward_zero).to_string() != "-2.34" || bigdecimal("7").rescale(3).to_string() != "7.000")
+            throw std::invalid_argument("Fail: Rescaling.");
+
+        if ((bigdecimal("10.00") / bigdecimal("3")).to_string() != "3.33" || bigdecimal("-2").divide(bigdecimal("3"), 4, mode::half_even).to_string() != "-0.6667" ||
+            bigdecimal("1").divide(bigdecimal("8"), 2, mode::half_even).to_string() != "0.12" || bigdecimal("0.001").divide(bigdecimal("-7"), 2, mode::half_up).to_string() != "0.00")
+            throw std::invalid_argument("Fail: Division.");
+
+        std::vector<bigdecimal> ledger = {bigdecimal("19.99"), bigdecimal("-5"), bigdecimal("0.125"), bigdecimal("100.10"), bigdecimal("-0.001")};
+        if (bigdecimal::sum(ledger.begin(), ledger.end()).to_string() != "115.214" || bigdecimal::sum(ledger.begin(), ledger.begin()) != bigdecimal())
+            throw std::invalid_argument("Fail: Batch summation.");
+
+        try
+        {
+            bigdecimal quotient = bigdecimal("1.0") / bigdecimal("0.00");
+            throw std::invalid_argument("Fail: Division by zero.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Division by zero")
+                throw;
+        }
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the modint and dyn_modint classes.
+ *
+ * This test checks arithmetic, powers and inverses against known values for
+ * compile-time moduli with and without Montgomery form, and for runtime moduli
+ * that are coprime to 10 and that fall back to `%`, plus invalid operations.
+ *
+ */
+void test_modint()
+{
+    try
+    {
+        std::cout << "Testing modint and dyn_modint: ";
+
+        using mod_prime = modint<1000000007>;
+        if (mod_prime(3).pow(1000000000000000000ULL).value() != 246336683 || mod_prime(2).inverse().value() != 500000004 ||
+            mod_prime(-5).value() != 1000000002 || (mod_prime(7) / mod_prime(7)).value() != 1 || (mod_prime(1) - mod_prime(2)).value() != 1000000006)
+            throw std::invalid_argument("Fail: Montgomery modint.");
+
+        if (modint<998244353>(3).pow((998244353 - 1) / 2) != modint<998244353>(-1) || modint<998244353>(bigint("-998244354")).value() != 998244352)
+            throw std::invalid_argument("Fail: Montgomery modint from bigint.");
+
+        // Above 2^63 and even moduli reduce with %
+        using mod_large = modint<18446744073709551557ULL>;
+        if ((mod_large(-1) * mod_large(-2)).value() != 2 || (mod_large(-1) + mod_large(-1)).value() != 18446744073709551555ULL ||
+            mod_large(12345).inverse().value() != 6398457523177343035ULL || (modint<1000000>(999999) * modint<1000000>(999999)).value() != 1)
+            throw std::invalid_argument("Fail: Fallback modint.");
+
+        bigint a("123456789012345678901234567890123");
+        bigint b("98765432109876543210987654321");
+        auto prime = std::make_shared<const montgomery_context>(bigint("170141183460469231731687303715884105727"));
+        dyn_modint x(a, prime), y(b, prime);
+        if (!prime->uses_montgomery() || (x * y).value() != bigint("25546389180899276408814119896414281888") ||
+            x.inverse().value() != bigint("162740126828002560959719273933521126029") || (x - y * dyn_modint(7, prime)).value() != bigint("122765430987576543098757654309876") ||
+            x.pow(prime->modulus() - 1).value() != 1 || (x / x).value() != 1 || (-x + x).value() != 0)
+            throw std::invalid_argument("Fail: Montgomery dyn_modint.");
+
+        auto even = std::make_shared<const montgomery_context>(bigint("100000000000000000004"));
+        dyn_modint u(a, even), w(b, even);
+        if (even->uses_montgomery() || (u * w).value() != bigint("30284973023702151963") || u.pow(bigint("10000000000000000000000003")).value() != bigint("31523824860754334635"))
+            throw std::invalid_argument("Fail: Fallback dyn_modint.");
+
+        try
+        {
+            dyn_modint mixed = x + u;
+            throw std::invalid_argument("Fail: Mismatched moduli.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Mismatched moduli")
+                throw;
+        }
+
+        try
+        {
+            dyn_modint inverse = dyn_modint(2, even).inverse();
+            throw std::invalid_argument("Fail: Inverse of a non-coprime value.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Inverse does not exist")
+                throw;
+        }
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the bigint_poly class.
+ *
+ * This test checks printing, the Kronecker product against the schoolbook one
+ * with signed coefficients, and evaluation at many points with the remainder
+ * tree against Horner's rule.
+ *
+ */
+void test_bigint_poly()
+{
+    try
+    {
+        std::cout << "Testing bigint_poly: ";
+
+        bigint_poly p({bigint(5), bigint(-1), bigint(3)});
+        bigint_poly q({bigint(-7), bigint(0), bigint(1)});
+        if (p.to_string() != "3x^2 - x + 5" || bigint_poly().to_string() != "0" || (p * q).to_string() != "3x^4 - x^3 - 16x^2 + 7x - 35")
+            throw std::invalid_argument("Fail: Printing and multiplication.");
+
+        if ((p - p).degree() != -1 || (p + q).coefficient(2) != 4 || (-q).coefficient(0) != 7)
+            throw std::invalid_argument("Fail: Addition and subtraction.");
+
+        // Mixed signs and sizes, including carries between the packed slots
+        std::vector<bigint> a_coeffs, b_coeffs;
+        for (int64_t i = 0; i < 40; ++i)
+        {
+            a_coeffs.push_back(bigint(i % 3 == 0 ? -999999 : 123457 * i));
+            b_coeffs.push_back(i % 4 == 0 ? bigint(std::string(30, '9')) : bigint(-i * i));
+        }
+        bigint_poly a(a_coeffs), b(b_coeffs);
+        bigint_poly expected = bigint_poly::multiply_schoolbook(a, b);
+        if (bigint_poly::multiply_kronecker(a, b) != expected || bigint_poly::multiply_kronecker(b, -a) != -expected || a * b != expected)
+            throw std::invalid_argument("Fail: Kronecker substitution.");
+
+        std::vector<bigint> points;
+        for (int64_t x = -12; x <= 12; ++x)
+            points.push_back(bigint(x * 7));
+        std::vector<bigint> horner;
+        for (const bigint &x : points)
+            horner.push_back(a.evaluate(x));
+        size_t threshold = bigint_poly::get_remainder_tree_threshold();
+        bigint_poly::set_remainder_tree_threshold(2);
+        bool tree_ok = a.evaluate(points) == horner && p.evaluate(std::vector<bigint>{bigint(2), bigint(-3)}) == std::vector<bigint>{bigint(15), bigint(35)};
+        bigint_poly::set_remainder_tree_threshold(threshold);
+        if (!tree_ok)
+            throw std::invalid_argument("Fail: Multipoint evaluation.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the bigint_matrix class.
+ *
+ * This test checks the blocked, Strassen-Winograd and multi-modular products
+ * against a plain triple loop on rectangular and odd-sized matrices with signed
+ * entries, the multi-modular product on several threads, and mismatched shapes.
+ *
+ */
+void test_bigint_matrix()
+{
+    try
+    {
+        std::cout << "Testing bigint_matrix: ";
+
+        bigint_matrix m(2, 2, {bigint(1), bigint(2), bigint(3), bigint(4)});
+        if (m * m != bigint_matrix(2, 2, {bigint(7), bigint(10), bigint(15), bigint(22)}) || m * bigint_matrix::identity(2) != m || (m - m) + m != m)
+            throw std::invalid_argument("Fail: Small products.");
+
+        // Signed entries of mixed sizes, including zeros and values past one prime
+        auto fill = [](size_t rows, size_t cols, int64_t seed)
+        {
+            std::vector<bigint> entries;
+            for (size_t i = 0; i < rows * cols; ++i)
+            {
+                int64_t k = static_cast<int64_t>(i) + seed;
+                bigint entry = k % 5 == 0 ? bigint(0) : bigint(std::to_string(k * 7919) + std::string(static_cast<size_t>(k % 40), '7'));
+                entries.push_back(k % 3 == 0 ? -entry : entry);
+            }
+            return bigint_matrix(rows, cols, entries);
+        };
+        bigint_matrix a = fill(7, 9, 1), b = fill(9, 5, 11), sq = fill(9, 9, 3);
+        bigint_matrix expected(7, 5), expected_sq(9, 9);
+        for (size_t i = 0; i < 9; ++i)
+            for (size_t j = 0; j < 9; ++j)
+                for (size_t k = 0; k < 9; ++k)
+                {
+                    if (i < 7 && j < 5)
+                        expected(i, j) += a(i, k) * b(k, j);
+                    expected_sq(i, j) += sq(i, k) * sq(k, j);
+                }
+
+        if (bigint_matrix::multiply_blocked(a, b) != expected || bigint_matrix::multiply_blocked(sq, sq) != expected_sq)
+            throw std::invalid_argument("Fail: Blocked product.");
+        if (bigint_matrix::multiply_strassen(a, b) != expected || bigint_matrix::multiply_strassen(sq, sq) != expected_sq)
+            throw std::invalid_argument("Fail: Strassen-Winograd product.");
+
+        size_t threads = bigint_matrix::get_thread_count();
+        bigint_matrix::set_thread_count(3);
+        bool multimodular_ok = bigint_matrix::multiply_multimodular(a, b) == expected && bigint_matrix::multiply_multimodular(sq, sq) == expected_sq;
+        bigint_matrix::set_thread_count(threads);
+        if (!multimodular_ok || bigint_matrix::multiply_multimodular(a, b) != expected || a * b != expected || sq * sq != expected_sq)
+            throw std::invalid_argument("Fail: Multi-modular product.");
+
+        try
+        {
+            bigint_matrix product = a * a;
+            throw std::invalid_argument("Fail: Mismatched dimensions.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Matrix dimensions don't match")
+                throw;
+        }
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_pool` class.
+ *
+ * This test checks that equal values interned from bigint, int64_t and string
+ * give the same handle, the reference counts of the handles, that collect()
+ * frees exactly the unreferenced values, and that concurrent interning from
+ * several threads still leaves one node per value.
+ *
+ */
+void test_bigint_pool()
+{
+    try
+    {
+        std::cout << "Testing bigint_pool: ";
+
+        bigint_pool pool;
+        bigint big("123456789012345678901234567890");
+        bigint_pool::handle a = pool.intern(big), b = pool.intern(bigint("123456789012345678901234567890")), c = pool.intern(std::string("00123456789012345678901234567890"));
+        bigint_pool::handle d = pool.intern(int64_t(-42)), e = pool.intern(std::string("-42")), f = pool.intern(bigint(-42));
+        if (a != b || a != c || d != e || d != f || a == d || &*a != &*b || *a != big || *d != bigint(-42) || a.hash() != big.hash())
+            throw std::invalid_argument("Fail: Interning equal values.");
+        if (a.use_count() != 3 || pool.size() != 2)
+            throw std::invalid_argument("Fail: Reference counts.");
+
+        {
+            bigint_pool::handle copy = a, moved = std::move(copy);
+            if (a.use_count() != 4 || copy || !moved)
+                throw std::invalid_argument("Fail: Copying handles.");
+        }
+        if (a.use_count() != 3 || std::hash<bigint_pool::handle>()(a) != big.hash())
+            throw std::invalid_argument("Fail: Releasing handles.");
+
+        d = e = f = bigint_pool::handle();
+        if (pool.collect() != 1 || pool.size() != 1 || pool.intern(big) != a)
+            throw std::invalid_argument("Fail: Collecting unreferenced values.");
+
+        // Four threads intern overlapping ranges; every value must end up in one node
+        std::vector<std::vector<bigint_pool::handle>> handles(4);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < handles.size(); ++t)
+            threads.emplace_back([&, t]
+                                 {
+                                     for (int64_t i = 0; i < 2000; ++i)
+                                         handles[t].push_back(pool.intern(bigint(i + 500 * static_cast<int64_t>(t)) * bigint("1000000000000000000000")));
+                                 });
+        for (std::thread &thread : threads)
+            thread.join();
+        for (size_t t = 1; t < handles.size(); ++t)
+            for (size_t i = 500; i < 2000; ++i)
+                if (handles[t][i - 500] != handles[t - 1][i] || *handles[t][i - 500] != bigint(static_cast<int64_t>(i + 500 * (t - 1))) * bigint("1000000000000000000000"))
+                    throw std::invalid_argument("Fail: Concurrent interning.");
+        pool.collect();
+        if (pool.size() != 3500 + 1)
+            throw std::invalid_argument("Fail: Concurrent interning.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `shared_bigint` class.
+ *
+ * This test checks that copies share their storage, that mutating a shared
+ * value copies it first and leaves the other copies alone, that a value owned
+ * alone is updated in place, and that the arithmetic matches `bigint`.
+ *
+ */
+void test_shared_bigint()
+{
+    try
+    {
+        std::cout << "Testing shared_bigint: ";
+
+        bigint big("123456789012345678901234567890");
+        shared_bigint a(big), b = a;
+        if (a.use_count() != 2 || &*a != &*b || a != b || *a != big)
+            throw std::invalid_argument("Fail: Sharing copies.");
+
+        b += shared_bigint(int64_t(10));
+        if (a.use_count() != 1 || b.use_count() != 1 || *a != big || *b != big + bigint(10))
+            throw std::invalid_argument("Fail: Copy on write.");
+
+        const bigint *storage = &*b;
+        b *= b;
+        b.addmul(a, shared_bigint(int64_t(-2)));
+        if (&*b != storage || *b != (big + bigint(10)) * (big + bigint(10)) - big * bigint(2))
+            throw std::invalid_argument("Fail: Mutating an unshared value.");
+
+        shared_bigint zero, other_zero;
+        if (&*zero != &*other_zero || *zero != bigint(0) || ++zero.mutate() != bigint(1) || *other_zero != bigint(0))
+            throw std::invalid_argument("Fail: Default values.");
+
+        shared_bigint x("-98765432109876543210"), y(int64_t(12345));
+        bigint bx("-98765432109876543210"), by(12345);
+        if (*(x + y) != bx + by || *(x - y) != bx - by || *(x * y) != bx * by || *(x / y) != bx / by || *(x % y) != bx % by || *(-x) != -bx || !(x < y) || !(y >= x) || std::hash<shared_bigint>()(x) != bx.hash())
+            throw std::invalid_argument("Fail: Arithmetic.");
+        const bigint &view = x;
+        if (view.to_string(16) != bx.to_string(16))
+            throw std::invalid_argument("Fail: Conversion to bigint.");
+
+        // A reader drops its copy on another thread; mutating after the count
+        // falls to 1 updates in place and must not race with the reader
+        shared_bigint reader_copy = x;
+        size_t digits_read = 0;
+        std::thread reader([&reader_copy, &digits_read]
+                           {
+                               shared_bigint local = std::move(reader_copy);
+                               digits_read = local->digits(); });
+        while (x.use_count() != 1)
+            std::this_thread::yield();
+        const bigint *before = &*x;
+        x.mutate() += bigint(1);
+        reader.join();
+        if (&*x != before || digits_read != 20 || *x != bx + bigint(1))
+            throw std::invalid_argument("Fail: Mutating after another thread's release.");
+
+        // Moved-from objects keep a value and stay usable
+        shared_bigint source(big), target = std::move(source);
+        source += target;
+        shared_bigint assigned(int64_t(5));
+        assigned = std::move(target);
+        target += assigned;
+        if (*source != big || *assigned != big || *target != big + bigint(5) || std::hash<shared_bigint>()(source) != big.hash())
+            throw std::invalid_argument("Fail: Moved-from objects.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_sort` class.
+ *
+ * This test sorts values of both signs, many lengths and many duplicates and
+ * compares the result with std::sort, and checks that the sort keys order like
+ * the values and map back to them.
+ *
+ */
+void test_bigint_sort()
+{
+    try
+    {
+        std::cout << "Testing bigint_sort: ";
+
+        bigint::counter_engine gen(91);
+        std::vector<bigint> values;
+        for (int i = 0; i < 3000; ++i)
+        {
+            // Short lengths give long runs of equal lengths and duplicates
+            size_t length = 1 + gen() % (i % 3 == 0 ? 3 : 40);
+            bigint value = bigint::random_digits(length, gen);
+            values.push_back(gen() % 2 ? -value : value);
+        }
+        values.push_back(bigint(0));
+        values.push_back(bigint(0));
+
+        std::vector<bigint> expected = values;
+        std::sort(expected.begin(), expected.end());
+        bigint_sort::sort(values.begin(), values.end());
+        if (values != expected)
+            throw std::invalid_argument("Fail: Sorting.");
+
+        std::vector<bigint> small = {bigint(3), bigint(-1), bigint(2)};
+        bigint_sort::sort(small.begin(), small.end());
+        if (small != std::vector<bigint>{bigint(-1), bigint(2), bigint(3)})
+            throw std::invalid_argument("Fail: Sorting few values.");
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            std::string key = bigint_sort::key(expected[i]);
+            if (bigint_sort::from_key(key) != expected[i])
+                throw std::invalid_argument("Fail: Key round trip.");
+            if (i > 0 && (expected[i - 1] < expected[i]) != (bigint_sort::key(expected[i - 1]) < key))
+                throw std::invalid_argument("Fail: Key order.");
+        }
+        if (!(bigint_sort::key(bigint(-100)) < bigint_sort::key(bigint(-99))) || !(bigint_sort::key(bigint(99)) < bigint_sort::key(bigint(100))) || !(bigint_sort::key(bigint(-1)) < bigint_sort::key(bigint(0))))
+            throw std::invalid_argument("Fail: Key order.");
+
+        try
+        {
+            bigint value = bigint_sort::from_key("abc");
+            throw std::invalid_argument("Fail: Invalid key.");
+        }
+        catch (const std::invalid_argument &e)
+        {
+            if (std::string(e.what()) != "Invalid sort key")
+                throw;
+        }
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `disk_bigint` class.
+ *
+ * This test checks the conversions to and from bigint and strings, and the
+ * block-wise product against the in-memory one, with blocks small enough that
+ * the operands take many passes, unequal lengths and all sign combinations.
+ *
+ */
+void test_disk_bigint()
+{
+    try
+    {
+        std::cout << "Testing disk_bigint: ";
+
+        bigint::counter_engine gen(92);
+        bigint a = bigint::random_digits(2500, gen), b = -bigint::random_digits(1700, gen);
+        disk_bigint da(a), db(b);
+        if (da.to_bigint() != a || db.to_bigint() != b || da.digits() != a.digits() || db.sign() != -1)
+            throw std::invalid_argument("Fail: Conversion from bigint.");
+
+        disk_bigint parsed(std::string("-000123456789"));
+        std::ostringstream out;
+        parsed.write(out);
+        if (parsed.to_bigint() != bigint(-123456789) || out.str() != "-123456789")
+            throw std::invalid_argument("Fail: Conversion from string.");
+
+        for (size_t block : {3, 200, 999, 100000})
+            if (disk_bigint::multiply(da, db, block).to_bigint() != a * b || disk_bigint::multiply(db, db, block).to_bigint() != b * b)
+                throw std::invalid_argument("Fail: Block-wise product.");
+
+        // All nines maximize the carries between blocks
+        bigint nines(std::string(3000, '9'));
+        disk_bigint dn(nines), zero(bigint(0));
+        if (disk_bigint::multiply(dn, dn, 300).to_bigint() != nines * nines || (dn * zero).sign() != 0 || (da * dn).to_bigint() != a * nines)
+            throw std::invalid_argument("Fail: Product with carries.");
+
+        // A rejected string must not leave its digit file mapped
+        auto mapped_files = []
+        {
+            std::ifstream maps("/proc/self/maps");
+            size_t count = 0;
+            for (std::string line; std::getline(maps, line);)
+                count += line.find("/bigint-") != std::string::npos;
+            return count;
+        };
+        size_t mapped = mapped_files();
+        for (const char *bad : {"12a4", "-", "9999x"})
+            try
+            {
+                disk_bigint invalid{std::string(bad)};
+                throw std::invalid_argument("Fail: Invalid string.");
+            }
+            catch (const std::invalid_argument &e)
+            {
+                if (std::string(e.what()) != "Invalid input string")
+                    throw;
+            }
+        if (mapped_files() != mapped)
+            throw std::invalid_argument("Fail: Mapping of an invalid string.");
+
+        // A moved-from object is empty and reads as zero
+        disk_bigint moved(std::move(parsed));
+        std::ostringstream empty_out;
+        parsed.write(empty_out);
+        if (moved.to_bigint() != bigint(-123456789) || parsed.digits() != 0 || parsed.sign() != 0 || parsed.digit(0) != 0 || parsed.to_bigint() != bigint(0) || empty_out.str() != "0")
+            throw std::invalid_argument("Fail: Moved-from object.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the streaming output of the `bigint` class.
+ *
+ * This test checks write_digits() and write() against a conversion by repeated
+ * division in every base, on values spanning several 64-bit words and on
+ * word boundaries, and checks that the chunks arrive in order and no larger
+ * than requested.
+ *
+ */
+void test_write_digits()
+{
+    try
+    {
+        std::cout << "Testing streaming output: ";
+
+        auto reference = [](bigint value, uint64_t base)
+        {
+            const char *symbols = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+            bool negative = value < 0;
+            if (negative)
+                value = -value;
+            std::string result;
+            do
+            {
+                result.push_back(symbols[std::stoi((value % bigint(static_cast<int64_t>(base))).to_string(10))]);
+                value /= bigint(static_cast<int64_t>(base));
+            } while (value != 0);
+            if (negative)
+                result.push_back('-');
+            std::reverse(result.begin(), result.end());
+            return result;
+        };
+
+        bigint two64 = bigint("18446744073709551616");
+        std::vector<bigint> values = {bigint(0), bigint(1), bigint(-35), two64, two64 - bigint(1), -(two64 * two64), bigint(std::string(200, '7')), -bigint("1" + std::string(150, '0'))};
+        for (const bigint &value : values)
+            for (uint64_t base = 2; base <= 36; ++base)
+                if (value.to_string(base) != reference(value, base))
+                    throw std::invalid_argument("Fail: Conversion in base " + std::to_string(base) + " of " + value.to_string(10) + ".");
+
+        bigint big = -bigint(std::string(1000, '9')) / bigint(7);
+        for (uint64_t base : {10, 16, 7})
+        {
+            std::string joined;
+            size_t calls = 0;
+            big.write_digits([&](const char *data, size_t size)
+                             {
+                                 if (size == 0 || size > 64)
+                                     throw std::invalid_argument("Fail: Chunk size.");
+                                 joined.append(data, size);
+                                 ++calls; },
+                             base, 64);
+            if (joined != big.to_string(base) || calls != (joined.size() + 63) / 64)
+                throw std::invalid_argument("Fail: Chunked output.");
+        }
+
+        std::ostringstream out;
+        big.write(out, 16) << ' ' << big;
+        if (out.str() != big.to_string(16) + ' ' + big.to_string(10))
+            throw std::invalid_argument("Fail: Stream output.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_parser` class.
+ *
+ * This test feeds texts in several bases split into chunks of various sizes,
+ * including values spanning many blocks, and compares the results with the
+ * string constructors. It also checks reading a stream, reuse after finish(),
+ * and the rejection of invalid texts.
+ *
+ */
+void test_bigint_parser()
+{
+    try
+    {
+        std::cout << "Testing bigint_parser: ";
+
+        std::mt19937 rng(2024);
+        const char *symbols = "0123456789abcdefghijklmnopqrstuvwxyz";
+        for (int base : {2, 7, 10, 16, 36})
+            for (size_t length : {1, 5, 13, 64, 300})
+            {
+                std::string text = rng() % 2 ? "-" : "";
+                for (size_t i = 0; i < length; ++i)
+                    text.push_back(symbols[rng() % static_cast<unsigned>(base)]);
+                bigint expected = base == 10 ? bigint(text) : bigint(text, base);
+
+                bigint_parser parser(base);
+                for (size_t chunk : {1, 3, 1000})
+                {
+                    for (size_t i = 0; i < text.size(); i += chunk)
+                        parser.feed(text.data() + i, std::min(chunk, text.size() - i));
+                    if (parser.digits() != length || parser.finish() != expected)
+                        throw std::invalid_argument("Fail: Chunked text in base " + std::to_string(base) + ".");
+                }
+            }
+
+        std::istringstream in("-000123456789012345678901234567890");
+        if (bigint_parser().read(in, 7).finish() != bigint("-123456789012345678901234567890"))
+            throw std::invalid_argument("Fail: Reading a stream.");
+        if (bigint_parser().feed("-").feed("0000").finish() != bigint(0) || bigint_parser(16).feed("-00").feed("FF").finish() != bigint(-255))
+            throw std::invalid_argument("Fail: Zeros and signs.");
+
+        for (auto bad : {std::make_pair(10, std::string("12a")), std::make_pair(2, std::string("102")), std::make_pair(10, std::string("1-2")), std::make_pair(16, std::string(""))})
+        {
+            bool thrown = false;
+            try
+            {
+                bigint_parser(bad.first).feed(bad.second).finish();
+            }
+            catch (const std::invalid_argument &)
+            {
+                thrown = true;
+            }
+            if (!thrown)
+                throw std::invalid_argument("Fail: Invalid text \"" + bad.second + "\" accepted.");
+        }
+
+        bool thrown = false;
+        try
+        {
+            bigint_parser parser(37);
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        if (!thrown)
+            throw std::invalid_argument("Fail: Base 37 accepted.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_arena` class.
+ *
+ * This test stores values and a table in a named shared memory segment,
+ * opens the segment again read-only at another address and uses the views
+ * there, and checks that a forked process can store and publish a value in an
+ * anonymous arena for its parent. It also checks the rejection of bad offsets
+ * and of writes through a read-only mapping.
+ *
+ */
+void test_bigint_arena()
+{
+    try
+    {
+        std::cout << "Testing bigint_arena: ";
+
+        std::string name = "/bigint_test_" + std::to_string(getpid());
+        std::vector<bigint> primes = {bigint(2), bigint(3), bigint("170141183460469231731687303715884105727")};
+        bigint big = -bigint("1" + std::string(500, '0')) + bigint(1);
+        {
+            bigint_arena writer = bigint_arena::create(name, 1 << 16);
+            writer.publish("primes", writer.store_table(primes.begin(), primes.end()));
+            writer.publish("big", writer.store(big));
+            writer.publish("zero", writer.store(bigint(0)));
+        }
+
+        bigint_arena reader = bigint_arena::open(name);
+        bigint_arena::table table = reader.get_table(reader.find("primes"));
+        bigint_arena::view v = reader.get(reader.find("big")), zero = reader.get(reader.find("zero"));
+        if (table.size() != 3 || table[2] != primes[2] || !(primes[1] == table[1]) || table.at(0) >= table[1])
+            throw std::invalid_argument("Fail: Shared table.");
+        if (v.to_bigint() != big || v.digits() != 500 || v.sign() != -1 || zero.sign() != 0 || !(v < zero) || reader.find("missing") != 0)
+            throw std::invalid_argument("Fail: Shared values.");
+        if (v + table[2] != big + primes[2] || table[2] * table[1] != primes[2] * primes[1] || big % table[2] != v % primes[2] || -v != -big)
+            throw std::invalid_argument("Fail: Arithmetic on views.");
+        std::ostringstream out;
+        out << v;
+        if (out.str() != big.to_string(10))
+            throw std::invalid_argument("Fail: View output.");
+
+        bool rejected = false;
+        try
+        {
+            reader.store(bigint(1));
+        }
+        catch (const std::runtime_error &)
+        {
+            rejected = true;
+        }
+        try
+        {
+            reader.get(reader.find("primes"));
+            rejected = false;
+        }
+        catch (const std::invalid_argument &)
+        {
+        }
+        if (!rejected || !bigint_arena::remove(name) || bigint_arena::remove(name))
+            throw std::invalid_argument("Fail: Misuse of an arena.");
+
+        bigint_arena shared(1 << 16);
+        pid_t child = fork();
+        if (child == 0)
+        {
+            shared.publish("child", shared.store(bigint("98765432109876543210")));
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (child < 0 || !WIFEXITED(status) || shared.get(shared.find("child")) != bigint("98765432109876543210"))
+            throw std::invalid_argument("Fail: Arena shared with a child process.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_file` class.
+ *
+ * This test saves values of many sizes and signs, loads them back in one
+ * batch, in many small batches read by the background thread and into a
+ * preallocated range, and checks that truncated and corrupted files and
+ * mismatched ranges are rejected.
+ *
+ */
+void test_bigint_file()
+{
+    try
+    {
+        std::cout << "Testing bigint_file: ";
+
+        const char *tmpdir = std::getenv("TMPDIR");
+        std::string path = std::string(tmpdir && *tmpdir ? tmpdir : "/tmp") + "/bigint_file_test_" + std::to_string(getpid());
+        bigint::counter_engine gen(99);
+        std::vector<bigint> values = {bigint(0), bigint(-1), bigint(std::string(5000, '9'))};
+        for (size_t i = 0; i < 3000; ++i)
+            values.push_back(bigint::random_digits(1 + gen() % 60, gen) * bigint(gen() % 2 ? 1 : -1));
+
+        bigint_file::save(path, values.begin(), values.end());
+        if (bigint_file::count(path) != values.size() || bigint_file::load(path) != values || bigint_file::load(path, 256) != values)
+            throw std::invalid_argument("Fail: Round trip.");
+
+        std::vector<bigint> reused(values.size(), bigint(std::string(100, '7')));
+        bigint_file::load(path, reused.begin(), reused.end(), 1000);
+        if (reused != values)
+            throw std::invalid_argument("Fail: Loading into a preallocated range.");
+
+        std::vector<bigint> empty;
+        bigint_file::save(path, empty.begin(), empty.end());
+        if (!bigint_file::load(path).empty())
+            throw std::invalid_argument("Fail: Empty file.");
+
+        auto rejected = [&](const std::function<void()> &action)
+        {
+            try
+            {
+                action();
+            }
+            catch (const std::exception &)
+            {
+                return true;
+            }
+            return false;
+        };
+
+        // Corrupt a digit far from the start, so the background thread has read batches before it
+        bigint_file::save(path, values.begin(), values.end());
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(-10, std::ios::end);
+            file.put(static_cast<char>(10));
+        }
+        bool corrupted = rejected([&]
+                                  { bigint_file::load(path, reused.begin(), reused.end(), 256); });
+        if (std::count(reused.begin(), reused.end(), bigint(0)) != static_cast<std::ptrdiff_t>(reused.size()))
+            throw std::invalid_argument("Fail: Range reset after a failed load.");
+        bigint_file::save(path, values.begin(), values.end());
+        bool mismatched = rejected([&]
+                                   { bigint_file::load(path, reused.begin(), reused.end() - 1); });
+        if (truncate(path.c_str(), 5000) != 0)
+            throw std::invalid_argument("Fail: Cannot truncate the test file.");
+        bool truncated = rejected([&]
+                                  { bigint_file::load(path); });
+        bool missing = rejected([&]
+                                { bigint_file::load(path + ".missing"); });
+
+        // A header claiming 2^40 digits in a file shorter than its digit column
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            uint64_t fields[4] = {0, 1, uint64_t(1) << 40, 0};
+            std::memcpy(fields, "BIGINTC1", 8);
+            int64_t length = int64_t(1) << 40;
+            file.write(reinterpret_cast<const char *>(fields), sizeof(fields));
+            file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+        }
+        bool oversized = rejected([&]
+                                  { bigint_file::count(path); }) &&
+                         rejected([&]
+                                  { bigint_file::load(path); });
+        std::remove(path.c_str());
+        if (!corrupted || !mismatched || !truncated || !missing || !oversized)
+            throw std::invalid_argument("Fail: Invalid files accepted.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_accumulator` class.
+ *
+ * This test adds and subtracts random values of mixed lengths and signs and
+ * compares the sum with bigint arithmetic, including sums that change sign,
+ * explicit normalizations in between, and accumulators filled by several
+ * threads and merged.
+ *
+ */
+void test_bigint_accumulator()
+{
+    try
+    {
+        std::cout << "Testing bigint_accumulator: ";
+
+        bigint::counter_engine gen(4242);
+        std::vector<bigint> values(2000);
+        for (bigint &value : values)
+        {
+            value = bigint::random_digits(1 + gen() % 80, gen);
+            if (gen() % 3 == 0)
+                value = -value;
+        }
+
+        bigint expected(0);
+        bigint_accumulator sum;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i % 7 == 3)
+            {
+                sum -= values[i];
+                expected -= values[i];
+            }
+            else
+            {
+                sum += values[i];
+                expected += values[i];
+            }
+            if (i % 500 == 0)
+                sum.normalize();
+            if (i % 100 == 0 && sum.value() != expected)
+                throw std::invalid_argument("Fail: Running sum.");
+        }
+        if (sum.value() != expected)
+            throw std::invalid_argument("Fail: Final sum.");
+
+        // A sum that crosses zero and ends negative, with a normalized negative top slot
+        bigint_accumulator crossing(bigint("1000000000000"));
+        crossing -= bigint("999999999999");
+        crossing -= bigint("5");
+        if (crossing.value() != bigint(-4))
+            throw std::invalid_argument("Fail: Sign change.");
+        crossing.normalize();
+        crossing += bigint(4);
+        if (crossing.value() != bigint(0) || bigint_accumulator().value() != bigint(0))
+            throw std::invalid_argument("Fail: Zero sums.");
+
+        std::vector<bigint_accumulator> parts(4);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < parts.size(); ++t)
+            threads.emplace_back([&, t]
+                                 {
+                                     for (size_t i = t; i < values.size(); i += parts.size())
+                                         parts[t] += values[i]; });
+        for (std::thread &thread : threads)
+            thread.join();
+        bigint_accumulator total;
+        for (const bigint_accumulator &part : parts)
+            total.merge(part);
+        bigint direct(0);
+        for (const bigint &value : values)
+            direct += value;
+        if (total.value() != direct)
+            throw std::invalid_argument("Fail: Merged sums.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_scan` class and the in-place compound assignments.
+ *
+ * This test checks `+=` and `-=` against `+` and `-` across sign changes and
+ * self-assignment, compares every scan with prefix sums built one by one, in
+ * place and into outputs holding older values, and runs the parallel scans on
+ * one and several threads.
+ *
+ */
+void test_bigint_scan()
+{
+    try
+    {
+        std::cout << "Testing bigint_scan: ";
+
+        bigint::counter_engine gen(9898);
+        std::vector<bigint> values(1500);
+        for (bigint &value : values)
+        {
+            value = bigint::random_digits(1 + gen() % 60, gen);
+            if (gen() % 3 == 0)
+                value = -value;
+        }
+
+        for (size_t i = 0; i + 1 < values.size(); i += 37)
+        {
+            bigint sum = values[i];
+            sum += values[i + 1];
+            bigint difference = values[i];
+            difference -= values[i + 1];
+            if (sum != values[i] + values[i + 1] || difference != values[i] - values[i + 1])
+                throw std::invalid_argument("Fail: Compound assignment.");
+        }
+        bigint self("-999999999999999999999");
+        self += self;
+        if (self != bigint("-1999999999999999999998"))
+            throw std::invalid_argument("Fail: Self addition.");
+        self -= self;
+        if (self != bigint(0) || self.to_string(10) != "0")
+            throw std::invalid_argument("Fail: Self subtraction.");
+
+        bigint init("123456789012345678901234567890");
+        std::vector<bigint> inclusive(values.size()), exclusive(values.size());
+        bigint running(0);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            exclusive[i] = init + running;
+            running = running + values[i];
+            inclusive[i] = running;
+        }
+
+        std::vector<bigint> out(values.size(), bigint("-5555555555555555555555555555555555555555"));
+        if (bigint_scan::inclusive_scan(values.begin(), values.end(), out.begin()) != out.end() || out != inclusive)
+            throw std::invalid_argument("Fail: Inclusive scan.");
+        if (bigint_scan::exclusive_scan(values.begin(), values.end(), out.begin(), init) != out.end() || out != exclusive)
+            throw std::invalid_argument("Fail: Exclusive scan.");
+
+        std::vector<bigint> in_place = values;
+        bigint_scan::exclusive_scan(in_place.begin(), in_place.end(), in_place.begin(), init);
+        if (in_place != exclusive)
+            throw std::invalid_argument("Fail: Exclusive scan in place.");
+
+        size_t threads = bigint_threads::get_thread_count();
+        for (size_t count : {1, 3, 4})
+        {
+            bigint_threads::set_thread_count(count);
+            std::vector<bigint> parallel(values.size());
+            bigint_scan::parallel_inclusive_scan(values.begin(), values.end(), parallel.begin());
+            if (parallel != inclusive)
+                throw std::invalid_argument("Fail: Parallel inclusive scan.");
+            parallel = values;
+            if (bigint_scan::parallel_exclusive_scan(parallel.begin(), parallel.end(), parallel.begin(), init) != parallel.end() ||
+                parallel != exclusive)
+                throw std::invalid_argument("Fail: Parallel exclusive scan in place.");
+        }
+        bigint_threads::set_thread_count(threads);
+
+        std::vector<bigint> empty;
+        if (bigint_scan::parallel_inclusive_scan(empty.begin(), empty.end(), empty.begin()) != empty.end())
+            throw std::invalid_argument("Fail: Empty range.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_memo` class.
+ *
+ * This test compares factorials, binomial coefficients and powers with values
+ * built by repeated multiplication, checks the hit, miss and reuse counts,
+ * evicts results from a small cache in least recently used order, and looks
+ * up the same values from several threads.
+ *
+ */
+void test_bigint_memo()
+{
+    try
+    {
+        std::cout << "Testing bigint_memo: ";
+
+        std::vector<bigint> factorials{bigint(1)};
+        for (int64_t i = 1; i <= 300; ++i)
+            factorials.push_back(factorials.back() * bigint(i));
+
+        bigint_memo memo;
+        if (memo.factorial(0) != bigint(1) || memo.factorial(100) != factorials[100])
+            throw std::invalid_argument("Fail: Factorial.");
+        if (memo.factorial(101) != factorials[101] || memo.factorial(300) != factorials[300] || memo.factorial(100) != factorials[100])
+            throw std::invalid_argument("Fail: Factorial from a cached one.");
+        bigint_memo::statistics s = memo.stats();
+        if (s.hits != 1 || s.misses != 4 || s.reuses != 3 || s.entries != 4)
+            throw std::invalid_argument("Fail: Factorial statistics.");
+
+        for (uint64_t n : {0, 1, 2, 10, 57, 200})
+            for (uint64_t k = 0; k <= n + 1; k += 1 + n / 7)
+            {
+                bigint expected = k > n ? bigint(0) : factorials[n] / (factorials[k] * factorials[n - k]);
+                if (memo.binomial(n, k) != expected)
+                    throw std::invalid_argument("Fail: Binomial coefficient.");
+            }
+        size_t hits = memo.stats().hits;
+        if (memo.binomial(200, 150) != memo.binomial(200, 50) || memo.stats().hits != hits + 1)
+            throw std::invalid_argument("Fail: Symmetric binomial coefficients.");
+
+        // Large n with small k, including factors above INT64_MAX
+        bigint top("18446744073709551615"), trillion("1000000000000");
+        if (memo.binomial(UINT64_MAX, 1) != top || memo.binomial(UINT64_MAX, UINT64_MAX - 3) != top * (top - bigint(1)) * (top - bigint(2)) / bigint(6))
+            throw std::invalid_argument("Fail: Binomial coefficient of a 64-bit n.");
+        bigint expected_large(1);
+        for (int64_t i = 0; i < 20; ++i)
+            expected_large = expected_large * (trillion - bigint(i)) / bigint(i + 1);
+        if (memo.binomial(1000000000000ULL, 20) != expected_large)
+            throw std::invalid_argument("Fail: Binomial coefficient of a large n.");
+
+        bigint base("-123456789");
+        bigint power(1);
+        for (uint64_t e = 0; e <= 40; ++e)
+        {
+            if (memo.pow(base, e) != power)
+                throw std::invalid_argument("Fail: Power.");
+            power *= base;
+        }
+        if (memo.pow(bigint(0), 0) != bigint(1) || memo.pow(bigint(2), 100) != bigint("1267650600228229401496703205376"))
+            throw std::invalid_argument("Fail: Power edge cases.");
+        if (memo.pow10(25) != bigint("10000000000000000000000000") || memo.pow(bigint(10), 3) != bigint(1000))
+            throw std::invalid_argument("Fail: Powers of ten.");
+
+        // Three factorials of about 450 bytes each fit, the least recently used is evicted for a fourth
+        bigint_memo small(1700);
+        small.factorial(200);
+        small.factorial(210);
+        small.factorial(220);
+        small.factorial(200);
+        small.factorial(230);
+        s = small.stats();
+        if (s.evictions != 1 || s.entries != 3 || s.bytes > small.capacity())
+            throw std::invalid_argument("Fail: Eviction.");
+        small.factorial(210);
+        if (small.stats().misses != 5 || small.factorial(200) != factorials[200] || small.stats().hits != 2)
+            throw std::invalid_argument("Fail: Least recently used order.");
+        small.set_capacity(0);
+        if (small.stats().entries != 0 || small.stats().bytes != 0 || small.factorial(5) != bigint(120) || small.stats().entries != 0)
+            throw std::invalid_argument("Fail: Zero capacity.");
+        small.clear();
+        if (small.stats().misses != 0 || small.stats().evictions != 0)
+            throw std::invalid_argument("Fail: Clear.");
+
+        bigint_memo shared;
+        std::vector<int> correct(4, 0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < correct.size(); ++t)
+            threads.emplace_back([&, t]
+                                 {
+                                     for (uint64_t n = 0; n <= 300; n += 1 + t)
+                                         correct[t] += shared.factorial(n) == factorials[n] && shared.binomial(n, n / 3) == shared.binomial(n, n - n / 3); });
+        for (std::thread &thread : threads)
+            thread.join();
+        for (size_t t = 0; t < correct.size(); ++t)
+            if (correct[t] != static_cast<int>(300 / (1 + t) + 1))
+                throw std::invalid_argument("Fail: Concurrent lookups.");
+        if (&bigint_memo::global() != &bigint_memo::global() || bigint_memo::global().factorial(20) != factorials[20])
+            throw std::invalid_argument("Fail: Global cache.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_expr` class.
+ *
+ * This test checks that building expressions computes nothing, that equal
+ * subexpressions share one node and are computed once, that unused branches
+ * stay unevaluated, that long chains evaluate without recursion, and that
+ * parallel evaluation gives the serial values and reports errors.
+ *
+ */
+void test_bigint_expr()
+{
+    try
+    {
+        std::cout << "Testing bigint_expr: ";
+
+        bigint_expr::graph g;
+        bigint_expr a = g.constant(bigint("123456789012345678901234567890"));
+        bigint_expr b = g.constant(bigint(-987654321));
+        bigint_expr used = (a * b + b * a) % (a - 7);
+        bigint_expr unused = (a * a * a * a) / b;
+        if (g.evaluations() != 0 || used.evaluated() || !a.evaluated())
+            throw std::invalid_argument("Fail: Lazy construction.");
+        if (a * b != b * a || a + 1 != a + bigint(1) || a - b == b - a || g.constant(bigint(-987654321)) != b)
+            throw std::invalid_argument("Fail: Common subexpressions.");
+
+        bigint x("123456789012345678901234567890"), y(-987654321);
+        if (used.value() != (x * y + y * x) % (x - bigint(7)))
+            throw std::invalid_argument("Fail: Value.");
+        // a * b, the sum, a - 7 and the remainder
+        if (g.evaluations() != 4 || unused.evaluated())
+            throw std::invalid_argument("Fail: Unused branches and shared subexpressions.");
+        used.value();
+        // Then a * a, its products with a, the quotient and the negation
+        if (g.evaluations() != 4 || (-unused).value() != -((x * x * x * x) / y) || g.evaluations() != 9)
+            throw std::invalid_argument("Fail: Cached values.");
+
+        // A chain deeper than the stack would allow for a recursive evaluation
+        bigint_expr chain = g.constant(bigint(0));
+        for (int64_t i = 1; i <= 200000; ++i)
+            chain += g.constant(bigint(i % 100));
+        if (chain.value() != bigint(200000 / 100 * 4950))
+            throw std::invalid_argument("Fail: Long chain.");
+
+        size_t threads = bigint_threads::get_thread_count();
+        for (size_t count : {1, 4})
+        {
+            bigint_threads::set_thread_count(count);
+            bigint_expr::graph h;
+            std::vector<bigint_expr> level;
+            std::vector<bigint> expected;
+            bigint::counter_engine gen(777);
+            for (int64_t i = 1; i <= 64; ++i)
+            {
+                level.push_back(h.constant(bigint::random_digits(50, gen)));
+                expected.push_back(level.back().value());
+            }
+            while (level.size() > 1)
+            {
+                std::vector<bigint_expr> next;
+                std::vector<bigint> next_expected;
+                for (size_t i = 0; i + 1 < level.size(); i += 2)
+                {
+                    next.push_back(level[i] * level[i + 1] - level[i]);
+                    next_expected.push_back(expected[i] * expected[i + 1] - expected[i]);
+                }
+                level = std::move(next);
+                expected = std::move(next_expected);
+            }
+            bigint_expr square = level[0] * level[0];
+            h.evaluate({level[0], square});
+            if (level[0].value() != expected[0] || square.value() != expected[0] * expected[0])
+                throw std::invalid_argument("Fail: Parallel evaluation.");
+
+            bigint_expr zero = h.constant(bigint(0));
+            bigint_expr failing = (square + level[0]) / (zero * square);
+            bool thrown = false;
+            try
+            {
+                failing.value();
+            }
+            catch (const std::invalid_argument &)
+            {
+                thrown = true;
+            }
+            if (!thrown || failing.evaluated() || !(zero * square).evaluated())
+                throw std::invalid_argument("Fail: Division by zero.");
+        }
+        bigint_threads::set_thread_count(threads);
+
+        bigint_expr::graph other;
+        bool thrown = false;
+        try
+        {
+            a + other.constant(bigint(1));
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        if (!thrown)
+            throw std::invalid_argument("Fail: Mixed graphs.");
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
+/**
+ * @brief Tests the `bigint_threads` class.
+ *
+ * This test runs parallel loops on one and several threads, checks that every
+ * index runs once, that the thread count is shared with `bigint_matrix`, and
+ * that an exception thrown by a task is rethrown to the caller.
+ *
+ */
+void test_bigint_threads()
+{
+    try
+    {
+        std::cout << "Testing bigint_threads: ";
+
+        size_t threads = bigint_threads::get_thread_count();
+        bigint_matrix::set_thread_count(3);
+        if (bigint_threads::get_thread_count() != 3)
+            throw std::invalid_argument("Fail: Shared thread count.");
+        bigint_threads::set_thread_count(0);
+        if (bigint_matrix::get_thread_count() != 1)
+            throw std::invalid_argument("Fail: Thread count of at least 1.");
+
+        for (size_t count : {1, 4})
+        {
+            bigint_threads::set_thread_count(count);
+            std::vector<int> runs(1000, 0);
+            bigint_threads::parallel_for(runs.size(), [&](size_t i)
+                                         { ++runs[i]; });
+            if (std::count(runs.begin(), runs.end(), 1) != 1000)
+                throw std::invalid_argument("Fail: Every index once.");
+
+            bool caught = false;
+            try
+            {
+                bigint_threads::parallel_for(100, [](size_t i)
+                                             {
+                                                 if (i % 7 == 3)
+                                                     throw std::runtime_error("task"); });
+            }
+            catch (const std::runtime_error &e)
+            {
+                caught = std::string(e.what()) == "task";
+            }
+            if (!caught)
+                throw std::invalid_argument("Fail: Exception from a task.");
+        }
+        bigint_threads::set_thread_count(threads);
+
+        std::cout << "Pass.\n";
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cout << e.what() << '\n';
+    }
+}
+
 int main()
 {
     test_default_constructor();
@@ -841,4 +2540,26 @@ int main()
     test_modulus();
     test_string_base_constructor();
     test_to_string();
+    test_memory_usage();
+    test_random();
+    test_hash();
+    test_bigrational();
+    test_bigfloat();
+    test_bigdecimal();
+    test_modint();
+    test_bigint_poly();
+    test_bigint_matrix();
+    test_bigint_pool();
+    test_shared_bigint();
+    test_bigint_sort();
+    test_disk_bigint();
+    test_write_digits();
+    test_bigint_parser();
+    test_bigint_arena();
+    test_bigint_file();
+    test_bigint_accumulator();
+    test_bigint_scan();
+    test_bigint_memo();
+    test_bigint_expr();
+    test_bigint_threads();
 }
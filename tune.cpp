@@ -0,0 +1,275 @@
+/**
+ * @file tune.cpp
+ * @author Zicheng Zhao (zhaoz149@mcmaster.ca)
+ * @brief A tuning program for the bigint class
+ * @version 0.1
+ * @date 2024-12-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "bigint.hpp"
+#include "bigint_matrix.hpp"
+#include "bigint_poly.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Generates a random decimal string with exactly the given number of digits.
+ *
+ * @param digits The number of digits (at least 1)
+ * @param rng The random engine to draw digits from
+ * @return std::string The generated digit string, without leading zeros
+ */
+std::string random_digits(size_t digits, std::mt19937_64 &rng)
+{
+    std::uniform_int_distribution<int> first(1, 9);
+    std::uniform_int_distribution<int> rest(0, 9);
+
+    std::string str(1, static_cast<char>('0' + first(rng)));
+    for (size_t i = 1; i < digits; ++i)
+        str.push_back(static_cast<char>('0' + rest(rng)));
+    return str;
+}
+
+/**
+ * @brief Measures the average wall time of an operation in nanoseconds.
+ *
+ * @param op The operation to measure
+ * @return double The average time per call
+ */
+template <typename Op>
+double time_ns(Op op)
+{
+    using clock = std::chrono::steady_clock;
+    const auto min_time = std::chrono::milliseconds(50);
+
+    op();
+    size_t reps = 0;
+    auto begin = clock::now();
+    auto end = begin;
+    do
+    {
+        op();
+        ++reps;
+        end = clock::now();
+    } while (end - begin < min_time);
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(reps);
+}
+
+/**
+ * @brief Fits and prints the cost of one operation as c * n^order.
+ *
+ * The operation is timed at each size and the constant `c` is reported per size;
+ * a constant that drifts upwards shows where the algorithm falls out of cache or
+ * where a faster algorithm would start to pay off.
+ *
+ * @param name The operation name
+ * @param order The expected exponent of the cost in the digit count
+ * @param sizes The digit counts to measure
+ * @param make_op Builds the operation to time for a given digit count
+ */
+template <typename MakeOp>
+void fit_cost(const std::string &name, int order, const std::vector<size_t> &sizes, MakeOp make_op)
+{
+    std::cout << name << " (ns / digit" << (order == 2 ? "^2" : "") << "):";
+    for (size_t digits : sizes)
+    {
+        double ns = time_ns(make_op(digits));
+        double scale = static_cast<double>(digits);
+        if (order == 2)
+            scale *= static_cast<double>(digits);
+        std::cout << "  " << digits << ":" << std::fixed << std::setprecision(3) << ns / scale;
+    }
+    std::cout << '\n';
+}
+
+/**
+ * @brief Times an operation under each candidate threshold and prints the best one.
+ *
+ * @param name The threshold name
+ * @param candidates The threshold values to try
+ * @param set Sets the threshold
+ * @param op The operation to time
+ */
+template <typename Set, typename Op>
+void sweep_threshold(const std::string &name, const std::vector<size_t> &candidates, Set set, Op op)
+{
+    size_t best = candidates.front();
+    double best_ns = std::numeric_limits<double>::max();
+    std::cout << name << " (us):";
+    for (size_t candidate : candidates)
+    {
+        set(candidate);
+        double ns = time_ns(op);
+        std::cout << "  " << candidate << ":" << std::fixed << std::setprecision(1) << ns / 1000.0;
+        if (ns < best_ns)
+        {
+            best = candidate;
+            best_ns = ns;
+        }
+    }
+    std::cout << "  -> " << best << '\n';
+}
+
+/**
+ * @brief Random polynomial with the given number of terms and coefficient digits.
+ *
+ * @param terms The number of coefficients
+ * @param digits The digits of each coefficient
+ * @param rng The random engine
+ * @return bigint_poly The polynomial
+ */
+bigint_poly random_poly(size_t terms, size_t digits, std::mt19937_64 &rng)
+{
+    std::vector<bigint> coefficients;
+    for (size_t i = 0; i < terms; ++i)
+        coefficients.push_back(rng() % 2 ? bigint(random_digits(digits, rng)) : -bigint(random_digits(digits, rng)));
+    return bigint_poly(coefficients);
+}
+
+/**
+ * @brief Times two methods over a range of sizes and prints where the second one starts to win.
+ *
+ * @param name The threshold name
+ * @param sizes The sizes to measure
+ * @param make_ops Builds the pair of operations to time for a given size
+ */
+template <typename MakeOps>
+void find_crossover(const std::string &name, const std::vector<size_t> &sizes, MakeOps make_ops)
+{
+    size_t crossover = 0;
+    std::cout << name << " (us, before/after):";
+    for (size_t size : sizes)
+    {
+        auto ops = make_ops(size);
+        double before = time_ns(ops.first);
+        double after = time_ns(ops.second);
+        std::cout << "  " << size << ":" << std::fixed << std::setprecision(1) << before / 1000.0 << "/" << after / 1000.0;
+        if (after < before && crossover == 0)
+            crossover = size;
+        else if (after >= before)
+            crossover = 0;
+    }
+    std::cout << "  -> " << (crossover == 0 ? "none" : std::to_string(crossover)) << '\n';
+}
+
+/**
+ * @brief Random matrix with entries of the given number of digits.
+ *
+ * @param rows The number of rows
+ * @param cols The number of columns
+ * @param digits The digits of each entry
+ * @param rng The random engine
+ * @return bigint_matrix The matrix
+ */
+bigint_matrix random_matrix(size_t rows, size_t cols, size_t digits, std::mt19937_64 &rng)
+{
+    std::vector<bigint> entries;
+    for (size_t i = 0; i < rows * cols; ++i)
+        entries.push_back(rng() % 2 ? bigint(random_digits(digits, rng)) : -bigint(random_digits(digits, rng)));
+    return bigint_matrix(rows, cols, entries);
+}
+
+/**
+ * @brief Main function to run the tuning sweeps.
+ *
+ * The program reports the cost constants of each operation over a sweep of
+ * sizes, then times the operations that switch algorithms under a range of
+ * thresholds and prints the fastest one, to be set at start-up or compiled in
+ * as the default.
+ *
+ * @return int Exit status.
+ */
+int main()
+{
+    std::mt19937_64 rng(42);
+    const std::vector<size_t> sizes = {16, 64, 256, 1024, 4096};
+
+    fit_cost("add", 1, sizes, [&](size_t digits)
+             {
+                 bigint a(random_digits(digits, rng));
+                 bigint b(random_digits(digits, rng));
+                 return [a, b]
+                 { bigint r = a + b; }; });
+
+    fit_cost("sub", 1, sizes, [&](size_t digits)
+             {
+                 bigint a(random_digits(digits, rng));
+                 bigint b(random_digits(digits, rng));
+                 return [a, b]
+                 { bigint r = a - b; }; });
+
+    fit_cost("mul", 2, sizes, [&](size_t digits)
+             {
+                 bigint a(random_digits(digits, rng));
+                 bigint b(random_digits(digits, rng));
+                 return [a, b]
+                 { bigint r = a * b; }; });
+
+    fit_cost("div", 2, {16, 64, 256, 1024}, [&](size_t digits)
+             {
+                 bigint a(random_digits(2 * digits, rng));
+                 bigint b(random_digits(digits, rng));
+                 return [a, b]
+                 { bigint r = a / b; }; });
+
+    const size_t karatsuba_default = bigint::get_karatsuba_threshold();
+    for (size_t digits : {1000, 4000})
+    {
+        bigint a(random_digits(digits, rng));
+        bigint b(random_digits(digits, rng));
+        sweep_threshold("karatsuba_threshold/" + std::to_string(digits), {16, 24, 32, 48, 64, 96, 128, digits + 1}, bigint::set_karatsuba_threshold, [&]
+                        { bigint r = a * b; });
+    }
+    bigint::set_karatsuba_threshold(karatsuba_default);
+
+    const size_t kronecker_default = bigint_poly::get_kronecker_threshold();
+    for (size_t digits : {1, 16, 64})
+    {
+        bigint_poly a = random_poly(64, digits, rng);
+        bigint_poly b = random_poly(64, digits, rng);
+        sweep_threshold("kronecker_threshold/64x" + std::to_string(digits), {8, 16, 32, 48, 65}, bigint_poly::set_kronecker_threshold, [&]
+                        { bigint_poly r = a * b; });
+    }
+    bigint_poly::set_kronecker_threshold(kronecker_default);
+
+    // The largest candidate means Horner's rule for every point
+    const size_t tree_default = bigint_poly::get_remainder_tree_threshold();
+    for (size_t points : {16, 64})
+    {
+        bigint_poly p = random_poly(points, 10, rng);
+        std::vector<bigint> xs;
+        for (size_t i = 0; i < points; ++i)
+            xs.push_back(bigint(random_digits(2, rng)));
+        sweep_threshold("remainder_tree_threshold/" + std::to_string(points), {2, points / 2, points + 1}, bigint_poly::set_remainder_tree_threshold, [&]
+                        { std::vector<bigint> values = p.evaluate(xs); });
+    }
+    bigint_poly::set_remainder_tree_threshold(tree_default);
+
+    // Entry size from which Strassen-Winograd beats the blocked loop on 8 x 8 matrices
+    find_crossover("strassen_threshold/8x8", {10, 20, 40, 80, 160}, [&](size_t digits)
+                   {
+                       bigint_matrix a = random_matrix(8, 8, digits, rng);
+                       bigint_matrix b = random_matrix(8, 8, digits, rng);
+                       return std::make_pair([a, b]
+                                             { bigint_matrix r = bigint_matrix::multiply_blocked(a, b); },
+                                             [a, b]
+                                             { bigint_matrix r = bigint_matrix::multiply_strassen(a, b); }); });
+
+    // Inner dimension from which the multi-modular method beats the blocked loop on 20-digit entries
+    find_crossover("multimodular_threshold/20", {4, 8, 16, 32}, [&](size_t inner)
+                   {
+                       bigint_matrix a = random_matrix(inner, inner, 20, rng);
+                       bigint_matrix b = random_matrix(inner, inner, 20, rng);
+                       return std::make_pair([a, b]
+                                             { bigint_matrix r = bigint_matrix::multiply_blocked(a, b); },
+                                             [a, b]
+                                             { bigint_matrix r = bigint_matrix::multiply_multimodular(a, b); }); });
+}